@@ -0,0 +1,26 @@
+#pragma once
+
+#include <stdint.h>
+
+// Background sampling of the analog inputs (joystick axes, photo sensor,
+// battery) with the ESP32-S3 continuous ADC: the DMA converts all inputs
+// round-robin and its frame interrupt averages ADC_OVERSAMPLE conversions
+// per input. Reads below only load the latest published value.
+// Needs Arduino-ESP32 core 3 (ESP-IDF 5 adc_continuous driver).
+
+void adcSamplerInit();
+
+// Latest average, ADC_BITS resolution (0..ADC_MAX); 0 for pins not sampled
+uint16_t adcSamplerRaw(uint8_t pin);
+
+// Latest averages of several pins (ADC_BITS) from one published set.
+// Returns when they were converted: micros() at the middle of the
+// averaging window of the oldest one. With the DMA running that is one
+// window (ADC_OVERSAMPLE conversions per input) or more in the past.
+uint32_t adcSamplerReadRaw(const uint8_t *pins, uint8_t count, uint16_t *out);
+
+// Same value with the oversampling bits kept: ADC_BITS + ADC_OVERSAMPLE_BITS
+uint16_t adcSamplerRawHiRes(uint8_t pin);
+
+// Calibrated pin voltage
+uint32_t adcSamplerMilliVolts(uint8_t pin);
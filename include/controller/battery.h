@@ -10,5 +10,6 @@ struct BatteryReading
 };
 
 void batteryInit();
+// Reads the battery once; call every BATTERY_READ_INTERVAL_MS
 void batteryTick();
 BatteryReading batteryGetReading();
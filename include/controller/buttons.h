@@ -2,6 +2,12 @@
 #include <Arduino.h>
 
 // Digital buttons wired directly to GPIOs.
+//
+// buttonsTick() reads all keys from one snapshot of the GPIO input
+// registers (scheduled every BUTTONS_SAMPLE_MS) and debounces them together as a
+// bitmask, so any number of keys can be held at once (chords). Queries
+// below answer from that state without pin I/O. Changes also go into an
+// event queue (press / release / long / repeat, timestamped) for the UI.
 
 enum class Key : uint8_t
 {
@@ -17,15 +23,45 @@ enum class Key : uint8_t
     JR
 };
 
-void buttonsTick(); // updates key state, does not consume events
+// Samples and debounces the keys; call every BUTTONS_SAMPLE_MS.
+// All queries below answer from the state of the last pass and never sample.
+void buttonsTick();
 
 void buttonsInit();
 
+enum class ButtonEventType : uint8_t
+{
+    Press = 0,
+    Release, // heldMs = press duration
+    Long,    // held for BUTTONS_LONG_MS, once per press
+    Repeat   // every BUTTONS_REPEAT_MS after Long while held
+};
+
+struct ButtonEvent
+{
+    uint32_t atMs;
+    uint32_t heldMs;
+    Key key;
+    ButtonEventType type;
+};
+
+// Oldest queued event; false when empty. BUTTONS_EVENT_QUEUE deep, a full
+// queue drops its oldest event. buttonsConsumeAll() empties it.
+bool buttonsPollEvent(ButtonEvent &ev);
+
+#define KEY_BIT(k) ((uint16_t)(1u << (uint8_t)(k)))
+
 /*
  * Debounced state: is the given key held down.
  */
 bool keyDown(Key k);
 
+// Debounced keys held, bit (1 << Key)
+uint16_t buttonsDownMask();
+
+// Chord: every key in mask (KEY_BIT(Key::F1) | KEY_BIT(Key::F2)) held
+bool keysHeld(uint16_t mask);
+
 /*
  * EVENT 1: Short click
  * - fires on RELEASE
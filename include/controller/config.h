@@ -44,14 +44,29 @@ enum class StartScreen : uint8_t
 #define BUTTON_DOWN_PIN HW_BTN_DOWN_PIN
 #define BUTTON_F1_PIN HW_BTN_F1_PIN
 #define BUTTON_F2_PIN HW_BTN_F2_PIN
+#define BUTTONS_SAMPLE_MS 8    // debounce: 4 equal samples = 24..32 ms
+#define BUTTONS_LONG_MS 800    // Long event
+#define BUTTONS_REPEAT_MS 300  // Repeat events after Long
+#define BUTTONS_EVENT_QUEUE 16
 
 // ===== Joysticks =====
 #define JOY_DEADZONE_DEFAULT 160
 #define JOY_EXPO_DEFAULT 1.8f
+// Stick noise filter (common/input_filter.h): 0=off 1=EMA 2=median 3=biquad 4=1 euro
+#define JOY_FILTER_TYPE_DEFAULT 0
+#define JOY_FILTER_STRENGTH_DEFAULT 2
+#define JOY_FILTER_RATE_DEFAULT_HZ 50 // until the control task reports its tick rate
 
 // ===== Display / OLED =====
 #define DISPLAY_MIN_FLUSH_INTERVAL_MS 50
 #define DISPLAY_UI_REFRESH_INTERVAL_MS 150
+// Display task (display.h): rendering and I2C off the control path
+#define DISPLAY_TASK_CORE 0      // radio and loop() stay on core 1
+#define DISPLAY_TASK_PRIORITY 1
+#define DISPLAY_TASK_STACK 4096
+#define DISPLAY_TASK_IDLE_MS 100 // wake without a new frame, for fault recovery
+#define DISPLAY_CMD_MAX 192      // overlay draw calls per frame
+#define DISPLAY_TEXT_POOL 128    // overlay string bytes per frame
 #define I2C_SCL_PIN HW_I2C_SCL_PIN
 #define I2C_SDA_PIN HW_I2C_SDA_PIN
 #define I2C_CLOCK_HZ HW_I2C_CLOCK_HZ
@@ -65,8 +80,44 @@ enum class StartScreen : uint8_t
 #define NRF_SCK_PIN HW_NRF_SCK_PIN
 #define NRF_MOSI_PIN HW_NRF_MOSI_PIN
 #define NRF_MISO_PIN HW_NRF_MISO_PIN
+#define NRF_IRQ_PIN HW_NRF_IRQ_PIN
 #define NRF_CHANNEL 76
 #define NRF_PA_LEVEL 0 // RF24_PA_MIN (range: 0=MIN .. 3=MAX)
+#define NRF_FHSS_ENABLED 1 // 1 = hop over COMM_HOP_COUNT channels, 0 = stay on NRF_CHANNEL
+// Link profile used until one is saved in settings (CommLinkProfile index):
+// 0=ROBUST 50 Hz @250k, 1=FAST 250 Hz @1M, 2=RACE 500 Hz @2M
+#define LINK_PROFILE_DEFAULT 0
+// Receiver failsafe: missed frame periods before it triggers (until saved in settings),
+// and how often the configuration is pushed to the receiver
+#define FAILSAFE_MISSED_PERIODS_DEFAULT 10
+#define FAILSAFE_PUSH_INTERVAL_MS 1000
+
+// ===== Control task =====
+// TX-synchronous control tick (control_task.h): stick sampling, frame build and send
+#define CONTROL_TASK_CORE 1      // alone on its core; UI and display run on core 0
+#define CONTROL_TASK_PRIORITY 5
+#define CONTROL_TASK_STACK 4096
+#define CONTROL_POLL_MS 1        // ACK polling between ticks
+
+// ===== UI task =====
+// Buttons, battery, menu, storage, LEDs and link gating (main.cpp)
+#define UI_TASK_CORE 0
+#define UI_TASK_PRIORITY 1
+#define UI_TASK_STACK 8192
+// Cooperative scheduler in the UI task (common/scheduler.h), periods:
+#define UI_TICK_MS 5            // menu, arming, models, display hand-over
+#define LEDS_TICK_MS 10         // receiver LEDs + strip show
+#define LINK_QUALITY_TICK_MS 20 // drains the link quality events
+#define SCHED_REPORT_MS 5000    // PERF_DEBUG: [SCHED] per-task timing
+
+// ===== Models / bind =====
+// Every model slot gets its own pair address once bound (derived from the MAC);
+// unbound slots use NRF_ADDR_DEFAULT, the address of unbound receivers.
+#define MODEL_COUNT 8
+#define MODEL_SCAN_DWELL_MS 6500     // per bound model while connecting; > receiver profile scan cycle
+#define MODEL_BIND_TIMEOUT_MS 10000
+#define MODEL_BIND_OFFER_MS 20       // bind offer repeat interval
+static const uint8_t NRF_ADDR_DEFAULT[5] = {'R', 'C', '0', '0', '1'};
 
 // ===== RGB LED =====
 #define LED_RGB_PIN HW_LED_RGB_PIN
@@ -76,6 +127,12 @@ enum class StartScreen : uint8_t
 #define ADC_MAX HW_ADC_MAX
 #define ADC_CENTER HW_ADC_CENTER
 
+// ===== Analog sampling =====
+// Inputs are converted continuously by the ADC DMA; every published value is
+// the average of 4^ADC_OVERSAMPLE_BITS conversions (+ADC_OVERSAMPLE_BITS bits).
+#define ADC_SAMPLE_RATE_HZ 48000 // conversions/s over all inputs (6 inputs -> 500 Hz per input at 16x)
+#define ADC_OVERSAMPLE_BITS 2
+
 // ===== EEPROM =====
 // Set to 1 to force writing defaults to EEPROM on boot (use once, then set back to 0).
 #define EEPROM_FORCE_DEFAULTS_ON_BOOT 0
@@ -83,7 +140,6 @@ enum class StartScreen : uint8_t
 // ===== Local battery measurement =====
 // Divider is: battery -> R_TOP -> ADC -> R_BOTTOM -> GND
 #define BATTERY_READ_INTERVAL_MS 200
-#define BATTERY_AVG_SAMPLES 8
 #define BATTERY_DIVIDER_R_TOP_OHM 33000UL
 #define BATTERY_DIVIDER_R_BOTTOM_OHM 20100UL
 #define BATTERY_CELL_EMPTY_MV 6600U
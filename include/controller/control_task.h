@@ -0,0 +1,37 @@
+#pragma once
+
+#include <stdint.h>
+
+// Control tick: a hardware timer (esp_timer) fires once per link profile
+// period and wakes a high-priority task on CONTROL_TASK_CORE, which it has
+// to itself; the UI, storage, LEDs and the display run on the other core
+// (main.cpp, display.h). The task takes
+// the latest stick averages (inputCapture()), builds the frame and queues
+// it right away, at a constant phase to the TX grid. The averages come
+// from the free-running ADC DMA (adc_sampler.h), so they are one
+// averaging window or more old; link_quality.h reports that age from the
+// conversion time, not from the capture. Between ticks it polls the radio
+// for ACKs.
+//
+// The task owns the radio: UI-side code that touches receiver or comm
+// state holds the control lock (ControlLockGuard). Per-tick state crosses
+// the cores without the lock (common/seqlock.h, common/spsc_queue.h).
+
+void controlTaskStart();
+
+// Ticks send the sticks (armed, main screen) or neutral frames.
+// Set once per UI pass from the whole gating decision, so a tick never
+// sees half of it.
+void controlSetLiveControls(bool live);
+
+// Recursive, so nested guards are fine
+void controlLock();
+void controlUnlock();
+
+struct ControlLockGuard
+{
+    ControlLockGuard() { controlLock(); }
+    ~ControlLockGuard() { controlUnlock(); }
+    ControlLockGuard(const ControlLockGuard &) = delete;
+    ControlLockGuard &operator=(const ControlLockGuard &) = delete;
+};
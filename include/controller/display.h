@@ -1,7 +1,17 @@
 #pragma once
 #include <Arduino.h>
-#include <U8g2lib.h>
 
+/*
+ * ===== Display =====
+ *
+ * Rendering and the I2C transfer run in a display task on
+ * DISPLAY_TASK_CORE, away from loop() and the control task. The UI side
+ * only edits text rows in RAM; displayTick() publishes a frame (rows +
+ * recorded overlay) through a lock-free buffer swap and wakes the task.
+ * Bus errors and OLED recovery are handled in the task as well.
+ */
+
+// Starts the display task (after Wire.begin()).
 void displayInit();
 void displayText(int row, const char* txt);
 void displayClear();
@@ -11,10 +21,39 @@ void displayClear();
 void displayFlush(bool force = false);
 
 // Must be called frequently (e.g., once per loop() iteration).
-// Performs actual render and background OLED/I2C recovery.
+// Publishes the pending frame to the display task; never touches the bus.
 void displayTick();
 
-// Pixel overlay: drawn BEFORE text in renderAll().
+// Overlay drawing calls, recorded on the UI side when a frame is
+// published and replayed by the display task after the text rows.
+// Same names as U8G2; strings are copied. Calls past the frame's
+// command space are dropped.
+struct DisplayFrame;
+class DisplayCanvas
+{
+public:
+    explicit DisplayCanvas(DisplayFrame &frame) : frame(frame) {}
+
+    void setDrawColor(uint8_t color);
+    void setFontMode(uint8_t mode);
+    void drawBox(int x, int y, int w, int h);
+    void drawLine(int x0, int y0, int x1, int y1);
+    void drawStr(int x, int y, const char *s);
+
+private:
+    DisplayFrame &frame;
+};
+
+// Pixel overlay: drawn after the text rows.
 // Pass nullptr, nullptr to disable.
-typedef void (*DisplayOverlayFn)(U8G2 &oled, void *ctx);
+typedef void (*DisplayOverlayFn)(DisplayCanvas &oled, void *ctx);
 void displaySetOverlay(DisplayOverlayFn fn, void *ctx);
+
+// Bus traffic of the renderer: pixel bytes of changed tiles only
+struct DisplayStats
+{
+    uint32_t lastFrameBytes; // 0..1024
+    uint32_t totalBytes;
+    uint32_t frames;
+};
+DisplayStats displayGetStats();
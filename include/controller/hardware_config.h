@@ -37,6 +37,7 @@
 #define HW_NRF_MOSI_PIN 36
 #define HW_NRF_CSN_PIN 37
 #define HW_NRF_CE_PIN 38
+#define HW_NRF_IRQ_PIN -1  // IRQ not routed on this PCB revision; -1 = poll STATUS
 
 // ===== RGB LED =====
 #define HW_LED_RGB_PIN 39
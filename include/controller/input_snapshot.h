@@ -0,0 +1,35 @@
+#pragma once
+
+#include <stdint.h>
+#include "common/axis_batch.h"
+#include "controller/buttons.h"
+
+// All operator inputs of one control tick. The control task
+// (control_task.h) calls inputCapture() right before it builds and sends
+// the frame; the UI pages read the same snapshot, so the frame sent and
+// the values shown come from the same sample.
+// Axis index: 0=lx,1=ly,2=rx,3=ry (same as joysticksGet*Axis()).
+
+#define INPUT_AXIS_COUNT 4
+
+struct InputSnapshot
+{
+    uint32_t atMs;
+    uint32_t atUs;                  // stick ADC conversion time (middle of the averaging window)
+    uint16_t raw[INPUT_AXIS_COUNT]; // physical ADC (no inversion)
+    int16_t axis[INPUT_AXIS_COUNT];   // filter + full stick curve, Q15 (+-AXIS_OUT_MAX = +-100 %)
+    int16_t linear[INPUT_AXIS_COUNT]; // calibration only (unfiltered), Q15
+    uint16_t keys;                  // debounced keys held, bit (1 << Key); debounced by buttonsTick()
+                                    // on the UI core (scheduler), read once per control tick
+};
+
+// Control task: samples and publishes; returns the conversion time (atUs)
+uint32_t inputCapture();
+
+// Any task: consistent copy of the latest snapshot
+InputSnapshot inputSnapshot();
+
+inline bool inputKeyDown(const InputSnapshot &in, Key k)
+{
+    return (in.keys & (1u << (uint8_t)k)) != 0;
+}
@@ -1,6 +1,8 @@
 #pragma once
 #include <Arduino.h>
 #include "controller/config.h"
+#include "common/axis_batch.h"
+#include "common/input_filter.h"
 
 // Initialize both joysticks
 void joystickInit();
@@ -22,40 +24,68 @@ int joysticksGetLimitAxis(uint8_t axis);
 void joysticksSetLimitAxis(uint8_t axis, int pct);
 void joysticksSaveLimit();
 
+// Noise filter per axis: 0=lx,1=ly,2=rx,3=ry. Runs on the physical ADC
+// value once per control tick, before the curve (see input_snapshot.h).
+InputFilterConfig joysticksGetFilterAxis(uint8_t axis);
+void joysticksSetFilterAxis(uint8_t axis, const InputFilterConfig &cfg);
+void joysticksSaveFilter();
+uint32_t joysticksGetFilterDelayUs(uint8_t axis); // at the current tick rate
+void joysticksSetFilterRate(uint32_t sampleRateHz); // control tick rate
+uint16_t joysticksFilterRaw(uint8_t axis, uint16_t raw);
+
+// Physical ADC values of all four axes (0=lx,1=ly,2=rx,3=ry) from one
+// sampler set; returns their conversion time (micros(), adc_sampler.h).
+uint32_t joysticksReadRaw(uint16_t *raw);
+
+// Control task (inside its locked tick): shapes all four axes
+// (0=lx,1=ly,2=rx,3=ry). filtered[] (noise filter output) is looked up in
+// each axis's full-curve table -> curveQ15[], raw[] runs the calibration
+// only -> linearQ15[]; both signed Q15, +-AXIS_OUT_MAX = +-100 %.
+void joysticksShape(const uint16_t *filtered, const uint16_t *raw, int16_t *curveQ15, int16_t *linearQ15);
+
+// UI task: the setters below only mark axes changed (under the control
+// lock). This re-tabulates the changed axes (one table entry per ADC value)
+// into the back buffer and swaps
+// it in under the lock, so the control task never waits for a rebuild.
+// Also called once in setup(), before the control task starts.
+void joysticksShapeTick();
+
+// Live transfer curve of an axis (0=lx,1=ly,2=rx,3=ry) on its positive half:
+// xNorm 0..1 of the calibrated span -> output percent 0..100, read from the
+// same table the stick reads use (deadzone, expo and limit included).
+float joysticksCurvePct(uint8_t axis, float xNorm);
+
 class Joystick {
 public:
     Joystick(uint8_t pinX, uint8_t pinY, uint8_t pinBtn);
 
     void begin();
 
-    float readX();
-    float readY();
-    float readLinearX();
-    float readLinearY();
-
-    void setInvertX(bool b) { invertX = b; }
-    void setInvertY(bool b) { invertY = b; }
+    // Setters and calibration take the control lock; the new curve goes
+    // live on the next joysticksShapeTick()
+    void setInvertX(bool b);
+    void setInvertY(bool b);
 
-    void setDeadzone(int dzX, int dzY) { deadzoneX = dzX; deadzoneY = dzY; }
+    void setDeadzone(int dzX, int dzY);
     int getDeadzoneX() const { return deadzoneX; }
     int getDeadzoneY() const { return deadzoneY; }
-    void setExpo(float e) { expoX = e; expoY = e; }
-    void setExpoX(float e) { expoX = e; }
-    void setExpoY(float e) { expoY = e; }
+    void setExpo(float e);
+    void setExpoX(float e);
+    void setExpoY(float e);
     float getExpoX() const { return expoX; }
     float getExpoY() const { return expoY; }
-    void setLimitPct(int pctX, int pctY) { limitPctX = pctX; limitPctY = pctY; }
-    void setLimitPctX(int pct) { limitPctX = pct; }
-    void setLimitPctY(int pct) { limitPctY = pct; }
+    void setLimitPct(int pctX, int pctY);
+    void setLimitPctX(int pct);
+    void setLimitPctY(int pct);
     int getLimitPctX() const { return limitPctX; }
     int getLimitPctY() const { return limitPctY; }
-    void setCenter(int cx, int cy) { centerX = cx; centerY = cy; }
+    void setCenter(int cx, int cy);
     int getCenterX() const { return centerX; }
     int getCenterY() const { return centerY; }
 
     // Calibration
     void startCalibration();
-    void updateCalibrationSample();
+    void updateCalibrationSample(int rawX, int rawY); // physical ADC values
     void finishCalibration();
     bool loadCalibration(const char *key);
     void saveCalibration(const char *key);
@@ -72,6 +102,17 @@ public:
     int readRawInvertedX() const;
     int readRawInvertedY() const;
 
+    // Physical ADC value -> control orientation
+    int applyInvert(int raw, bool isX) const;
+
+    // Shaper lane of an axis (joysticksShapeTick()): parameters, and whether
+    // they changed since the last call (clears the flag); under the lock
+    AxisParams shapeParams(bool isX) const;
+    bool takeShapeDirty(bool isX);
+
+    // Physical ADC value at xNorm 0..1 of the calibrated positive span
+    int curveRaw(bool isX, float xNorm) const;
+
 private:
     uint8_t pinX, pinY, pinBtn;
 
@@ -88,10 +129,13 @@ private:
     int calMinY = 0, calMaxY = ADC_MAX;
     int centerX = ADC_CENTER, centerY = ADC_CENTER;
 
+    bool shapeDirtyX = true;
+    bool shapeDirtyY = true;
+
+    void invalidateShape() { shapeDirtyX = true; shapeDirtyY = true; }
+    void axisRange(bool isX, int &calMin, int &calMax, int &calCenter) const;
+
     int readAxisRaw(uint8_t pin) const;
-    int applyInvert(int raw, bool isX) const;
-    float processAxisLinear(int raw, const char *axisName) const;
-    float processAxis(int raw, const char* axisName);
 };
 
 // Global instances of left and right joysticks
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdint.h>
+#include "controller/config.h"
+#include "common/comm.h"
+
+// Link health over the last closed 1 s window.
+struct LinkQualityStats
+{
+    bool valid;                // at least one window closed since reset
+    uint8_t lqPct;             // ACKed / sent frames, 0..100
+    uint16_t txPerSec;         // frames sent
+    uint16_t ackPerSec;        // frames ACKed
+    uint16_t rxPerSec;         // frames the receiver reports as received
+    uint8_t retriesAvgX10;     // average auto-retransmits per frame x10
+    uint8_t retriesMax;        // worst auto-retransmit count
+    uint8_t carrierPct;        // ACKs with RPD set (> -64 dBm), 0..100
+    uint16_t rttAvgUs;         // queue -> ACK seen, average
+    uint16_t rttMaxUs;         // queue -> ACK seen, worst
+    uint16_t tlmAgeAvgUs;      // telemetry payload age on arrival (FIFO wait + RTT), average
+    uint16_t tlmAgeMaxUs;      // telemetry payload age on arrival, worst
+    uint16_t tlmMissed;        // telemetry payloads lost or flushed as stale
+    uint16_t sampleAgeAvgUs;   // stick ADC conversion -> frame queued, average
+    uint16_t sampleAgeMaxUs;   // stick ADC conversion -> frame queued, worst
+    uint16_t tickLatencyAvgUs; // control timer -> stick capture, average (phase to the TX grid)
+    uint16_t tickJitterUs;     // control timer -> stick capture, worst - best
+};
+
+// Radio side (control task or control lock held): reset and feed.
+// Calls only queue the event; the UI applies them in linkQualityTick().
+void linkQualityReset();
+
+// Feed every completed frame (Acked / Failed) from commPollTx().
+void linkQualityOnTx(CommTxStatus status, const CommTxInfo &info);
+
+// Feed every frame that carried a fresh stick sample (control task):
+// sampleAgeUs = ADC conversion -> queued, tickLatencyUs = control timer -> capture.
+void linkQualityOnSend(uint32_t sampleAgeUs, uint32_t tickLatencyUs);
+
+// UI side: applies the queued events, closes the window once per second
+// and optionally exports it over Serial.
+void linkQualityTick(uint32_t nowMs);
+
+// UI side
+LinkQualityStats linkQualityGet();
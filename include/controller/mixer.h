@@ -0,0 +1,120 @@
+#pragma once
+#include <stdint.h>
+#include "common/comm.h"
+#include "controller/input_snapshot.h"
+
+/*
+ * ===== Mixer =====
+ *
+ * Sits between the stick pipeline and the frame encoder: every output
+ * channel is the sum of the mix lines that target it. A line takes a
+ * source, shapes it with a curve, scales it by weight, adds an offset and
+ * only counts while its condition (a switch key held / released) is true.
+ * A Replace line overrides whatever the lines before it put on the
+ * channel, so dual rates are two Replace lines on one output with
+ * opposite conditions.
+ *
+ * Per model (NVS "mix_cfg" + model id, like the failsafe):
+ * - MIX_LINES_MAX lines, a line with source None is unused;
+ * - trim per stick axis, added to the stick before the lines;
+ * - sub-trim per output channel, added after the lines.
+ *
+ * mixerSetConfig() compiles the used lines into a flat program of fixed
+ * point operations (Q15) without branches in the loop. Evaluation time is
+ * bounded by MIX_LINES_MAX ops plus one pass over the output channels.
+ */
+
+enum class MixSource : uint8_t
+{
+    None = 0,
+    LX,
+    LY,
+    RX,
+    RY,
+    JL, // switch keys: -100 % released, +100 % held
+    JR,
+    F1,
+    F2,
+    Max, // constant +100 %
+    Count
+};
+
+enum class MixCurve : uint8_t
+{
+    Linear = 0,
+    Positive, // negative half cut to 0
+    Negative, // positive half cut to 0
+    Absolute,
+    Count
+};
+
+enum class MixCondition : uint8_t
+{
+    Always = 0,
+    JlOn,
+    JlOff,
+    JrOn,
+    JrOff,
+    F1On,
+    F1Off,
+    F2On,
+    F2Off,
+    Count
+};
+
+enum class MixOp : uint8_t
+{
+    Add = 0,
+    Replace,
+    Count
+};
+
+#define MIX_LINES_MAX 24
+#define MIX_TRIM_MAX 25 // stick trim range, +-%
+
+struct MixLine
+{
+    uint8_t output; // channel 0..COMM_MAX_CHANNELS-1
+    MixSource source;
+    int8_t weight; // -100..100 %
+    int8_t offset; // -100..100 %
+    MixCurve curve;
+    MixCondition condition;
+    MixOp op;
+    uint8_t reserved;
+};
+
+struct MixerConfig
+{
+    uint8_t channelCount; // channels sent, 1..COMM_MAX_CHANNELS
+    int8_t trim[4];       // per stick axis (0=lx,1=ly,2=rx,3=ry), -MIX_TRIM_MAX..MIX_TRIM_MAX %
+    int8_t subtrim[COMM_MAX_CHANNELS]; // per output, -100..100 %
+    MixLine line[MIX_LINES_MAX];
+};
+
+struct MixerStats
+{
+    uint8_t opCount;     // compiled operations
+    uint32_t evalAvgNs;  // last report window
+    uint32_t evalMaxNs;
+    uint32_t windows;    // report windows closed so far (a new value = new numbers)
+};
+
+// Direct mapping: sticks to CH1..CH4, stick buttons and F1/F2 to CH5..CH8
+void mixerDefaults(MixerConfig &cfg);
+
+// Load (or default) the mixes of a model and make them live
+void mixerLoadModel(uint8_t modelId);
+void mixerSaveModel();
+
+const MixerConfig &mixerGetConfig();
+void mixerSetConfig(const MixerConfig &cfg);
+
+// Control task: live inputs -> output channels of the frame
+void mixerEvaluate(const InputSnapshot &in, CommFrame &out);
+
+MixerStats mixerGetStats();
+
+// UI side: prints each new report window to Serial when MIXER_DEBUG is on
+// (the control tick only publishes them)
+void mixerDebugTick();
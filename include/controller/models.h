@@ -0,0 +1,48 @@
+#pragma once
+#include <stdint.h>
+#include "controller/config.h"
+
+/*
+ * ===== Models =====
+ *
+ * A model slot ties a receiver (by its pair address) to the settings
+ * stored for it (link profile, failsafe). While the link is connecting
+ * the controller cycles through the bound models, so whichever bound
+ * receiver is powered up gets its model loaded automatically.
+ *
+ * Bound models can also be put in a group: the controller then serves
+ * all of them in time slots (see comm.h), the active model is driven by
+ * the sticks and the others get hold frames. Scanning is off then.
+ */
+enum class ModelBindState : uint8_t
+{
+    Idle = 0,
+    Binding, // offering the address on the bind channel
+    Done,    // receiver took the offer
+    Failed   // no receiver answered within MODEL_BIND_TIMEOUT_MS
+};
+
+// Loads model records and applies the last active model (after receiverInit()).
+void modelsInit();
+
+// Call every loop: bind state machine and model scanning.
+void modelsTick();
+
+uint8_t modelsGetActive();
+bool modelsIsBound(uint8_t modelId);
+
+// Pair address of the model (NRF_ADDR_DEFAULT while unbound).
+void modelsGetAddress(uint8_t modelId, uint8_t address[5]);
+
+// Makes modelId active and remembers it across power cycles.
+void modelsSelect(uint8_t modelId);
+
+// Group membership (bound models only, COMM_MAX_SLOTS including the active one).
+// False when the model cannot join.
+bool modelsInGroup(uint8_t modelId);
+bool modelsSetInGroup(uint8_t modelId, bool member);
+
+// Bind: the link is paused while binding and restored afterwards.
+void modelsBindStart(uint8_t modelId);
+void modelsBindCancel();
+ModelBindState modelsBindState();
@@ -1,5 +1,7 @@
 #pragma once
+#include "controller/config.h"
 #include "common/comm.h"
+#include "common/telemetry.h"
 
 enum class ReceiverLinkState : uint8_t
 {
@@ -13,14 +15,53 @@ enum class ReceiverLinkState : uint8_t
 // Inicjalizacja odbiornika (wymaga wczesniejszego commInit)
 void receiverInit(bool radioReady);
 
-// Wysyla ramke nadawcza i obsluguje odbior; ustawia LED 3RD wg baterii z ramki RX.
-// txFrame: lokalne wartosci do wyslania.
-void receiverLoop(const CommFrame& txFrame);
+// Called by the control task (control_task.h), which owns the radio:
+// poll collects the frame in flight (ACK, telemetry) and tracks link timeouts;
+// send queues the frame of one TX tick (ticks > 1: ticks were missed).
+// send returns true when txFrame itself went to the driven receiver.
+void receiverPoll();
+bool receiverSend(const CommFrame &txFrame, uint32_t ticks);
+// TX tick period of the active link profile
+uint32_t receiverGetTxPeriodUs();
+
+// UI task, every LEDS_TICK_MS: link state LED (1ST) and receiver battery LED (3RD);
+// also prints the debug lines queued by the control task (LINK_DEBUG, BATTERY_DEBUG).
+void receiverLedTick();
+
+// Receiver group (time slots, see comm.h): slot i is modelIds[i] on addresses[i].
+// The sticks drive drivenSlot, the other receivers get hold frames.
+// Failsafe is loaded per model, the link profile from the driven model.
+// Group membership is handled by models.h.
+void receiverSetGroup(const uint8_t *modelIds, const uint8_t (*addresses)[5], uint8_t count, uint8_t drivenSlot);
+uint8_t receiverGetSlotCount();
+uint8_t receiverGetDrivenSlot();
+uint8_t receiverGetSlotModel(uint8_t slot);
+
+// Model in the driven slot
+uint8_t receiverGetModel();
+
+// Active link profile; set applies it to the radio immediately, save stores it in NVS.
+CommLinkProfile receiverGetLinkProfile();
+void receiverSetLinkProfile(CommLinkProfile profile);
+void receiverSaveLinkProfile();
+
+// Receiver failsafe behaviour; set pushes it to the receiver, save stores it in NVS.
+const CommFailsafeConfig &receiverGetFailsafeConfig();
+void receiverSetFailsafeConfig(const CommFailsafeConfig &cfg);
+void receiverSaveFailsafeConfig();
 
 void receiverSetLinkEnabled(bool enabled);
 bool receiverIsLinkEnabled();
+// Link state and telemetry without a slot refer to the driven receiver.
 ReceiverLinkState receiverGetLinkState();
+ReceiverLinkState receiverGetSlotLinkState(uint8_t slot);
 const char *receiverGetLinkStateShortName();
+const char *receiverGetLinkStateShortName(ReceiverLinkState state);
+
+// Latest downlink telemetry item; false until the receiver has reported it.
+// ageMs (optional) receives the time since the item was last received.
+bool receiverGetTelemetry(TelemetryId id, uint32_t &value, uint32_t *ageMs = nullptr);
+bool receiverGetSlotTelemetry(uint8_t slot, TelemetryId id, uint32_t &value, uint32_t *ageMs = nullptr);
 
 // Ostatni odebrany stan baterii odbiornika z ramki RX.
 uint16_t receiverGetBatteryPct();
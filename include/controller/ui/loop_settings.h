@@ -9,6 +9,11 @@ enum class LoopSettingsResult
     StartLedTest,
     StartPhotoSettings,
     StartIoReadings,
+    StartLinkSettings,
+    StartFailsafeSettings,
+    StartModelSettings,
+    StartGroupSettings,
+    StartMixerSettings,
     ExitToMain
 };
 
@@ -0,0 +1,10 @@
+#pragma once
+
+enum class FailsafeSettingsResult
+{
+    Stay = 0,
+    ExitToSettings
+};
+
+void setFailsafeStart();
+FailsafeSettingsResult setFailsafeLoop();
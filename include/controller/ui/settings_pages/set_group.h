@@ -0,0 +1,10 @@
+#pragma once
+
+enum class GroupSettingsResult
+{
+    Stay = 0,
+    ExitToSettings
+};
+
+void setGroupStart();
+GroupSettingsResult setGroupLoop();
@@ -0,0 +1,10 @@
+#pragma once
+
+enum class LinkSettingsResult
+{
+    Stay = 0,
+    ExitToSettings
+};
+
+void setLinkStart();
+LinkSettingsResult setLinkLoop();
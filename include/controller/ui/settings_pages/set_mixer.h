@@ -0,0 +1,10 @@
+#pragma once
+
+enum class MixerSettingsResult
+{
+    Stay = 0,
+    ExitToSettings
+};
+
+void setMixerStart();
+MixerSettingsResult setMixerLoop();
@@ -0,0 +1,10 @@
+#pragma once
+
+enum class ModelSettingsResult
+{
+    Stay = 0,
+    ExitToSettings
+};
+
+void setModelStart();
+ModelSettingsResult setModelLoop();
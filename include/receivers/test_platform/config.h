@@ -9,10 +9,26 @@
 #define NRF24_SCK_PIN 13
 #define NRF24_MOSI_PIN 11
 #define NRF24_MISO_PIN 12
+#define NRF_IRQ_PIN 2 // INT0; frames are read in the IRQ handler. -1 = poll from loop()
 #define NRF_CHANNEL 76
 #define NRF_PA_LEVEL 0 // RF24_PA_MIN (range: 0=MIN .. 3=MAX)
+#define NRF_FHSS_ENABLED 1 // 1 = hop over COMM_HOP_COUNT channels, 0 = stay on NRF_CHANNEL
+// Pair address used until the receiver is bound to a controller
 static const uint8_t NRF_ADDR[5] = {'R', 'C', '0', '0', '1'};
+// Bind: hold BIND_BUTTON_PIN low at power-up (or boot never bound) to listen
+// for a bind offer for BIND_WINDOW_MS
+#define BIND_BUTTON_PIN 4
+#define BIND_WINDOW_MS 30000UL
+#define BIND_LINGER_MS 500UL // keep ACKing repeated offers before switching address
 #define NRF_ENABLED 1
+// Start profile (CommLinkProfile index). Without frames the receiver steps
+// through all profiles every NRF_PROFILE_SCAN_MS until it finds the controller.
+// Must exceed one hop cycle of the slowest profile with all time slots in use
+// (COMM_HOP_COUNT x COMM_MAX_SLOTS x 20 ms).
+#define NRF_LINK_PROFILE 0
+#define NRF_PROFILE_SCAN_MS 2100
+// Missed frame periods before failsafe, used until the controller pushes its config
+#define FAILSAFE_MISSED_PERIODS 10
 
 #define BATTERY_PIN A1
 #define BATTERY_READ_INTERVAL_MS 200
@@ -23,5 +39,26 @@ static const uint8_t NRF_ADDR[5] = {'R', 'C', '0', '0', '1'};
 #define BATTERY_CELL_EMPTY_MV 3300U
 #define BATTERY_CELL_FULL_MV 4200U
 
+// Servo / ESC outputs (receiver/output.h): 0 = PWM, 1 = PPM, 2 = SBUS.
+// SBUS takes the UART (needs an inverter), so it requires SERIAL_ENABLED 0.
+#define OUTPUT_ENABLED 1
+#define OUTPUT_MODE 0
+#define OUTPUT_PWM_RATE_HZ 50 // 50..400
+#define OUTPUT_COUNT 8
+// Output i follows frame channel OUTPUT_CHANNEL_MAP[i] (COMM_CH_LX, LY, RX, RY, AUX...)
+static const uint8_t OUTPUT_CHANNEL_MAP[OUTPUT_COUNT] = {0, 1, 2, 3, 4, 5, 6, 7};
+// PWM: pin per output, PPM: first pin only. Free of nRF24, IRQ, bind button and battery pins
+// (14, 16, 17 = A0, A2, A3).
+static const uint8_t OUTPUT_PINS[OUTPUT_COUNT] = {3, 5, 6, 9, 10, 14, 16, 17};
+
+// Frame smoothing between link frames (receiver/smoothing.h), per channel
+// in COMM_CH order: 0 = off (switches), 1 = linear, 2 = damped.
+// Damped strength: time constant in % of the frame interval.
+#define SMOOTH_ENABLED 1
+#define SMOOTH_EXTRAP_FRAMES 2 // keep moving across this many lost frames
+#define SMOOTH_CHANNELS 8
+static const uint8_t SMOOTH_MODE_MAP[SMOOTH_CHANNELS] = {2, 2, 2, 2, 0, 0, 0, 0};
+static const uint8_t SMOOTH_STRENGTH_MAP[SMOOTH_CHANNELS] = {50, 50, 50, 50, 0, 0, 0, 0};
+
 #define SERIAL_ENABLED 1
 #define SERIAL_BAUD 115200
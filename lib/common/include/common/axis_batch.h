@@ -0,0 +1,195 @@
+#pragma once
+#include <stdint.h>
+#include <math.h>
+
+/*
+ * ===== Batch axis processor =====
+ *
+ * Stick / channel shaping chain for several axes at once:
+ * invert -> calibration (center, per-side span) -> deadzone -> expo -> limit.
+ *
+ * Per-axis parameters live in contiguous arrays (one array per field), so a
+ * pass over all axes walks each array linearly. The hot path is integer
+ * only; float is used once per axis in setAxis() to tabulate the expo
+ * curve, so the same code runs on the ESP32 controller and the AVR
+ * receivers.
+ *
+ * Fixed point:
+ * - normalised deflection is Q15 with 1.0 = AXIS_ONE_Q15 (32768);
+ * - the expo curve is AXIS_CURVE_SEGMENTS linear segments of
+ *   x^(1 + expo), sampled in setAxis();
+ * - output is signed Q15, +-AXIS_OUT_MAX = +-100 %.
+ *
+ * The Features template argument (AXIS_FEAT_*) drops unused stages at
+ * compile time, e.g. AxisBatch<8, AXIS_FEAT_INVERT | AXIS_FEAT_LIMIT>
+ * for plain channel scaling.
+ */
+
+#define AXIS_FEAT_INVERT 0x01
+#define AXIS_FEAT_DEADZONE 0x02
+#define AXIS_FEAT_EXPO 0x04
+#define AXIS_FEAT_LIMIT 0x08
+#define AXIS_FEAT_ALL 0x0F
+
+#define AXIS_ONE_Q15 32768L
+#define AXIS_OUT_MAX 32767
+#define AXIS_CURVE_SEGMENTS 64 // power of two
+#define AXIS_CURVE_SHIFT 9     // log2(AXIS_ONE_Q15 / AXIS_CURVE_SEGMENTS)
+
+#define AXIS_EXPO_MAX 3.0f
+
+struct AxisParams
+{
+    uint16_t adcMax; // full-scale raw value (inversion mirrors around it)
+    uint16_t calMin;
+    uint16_t calCenter;
+    uint16_t calMax;
+    uint16_t deadzone; // raw counts around the center
+    float expo;        // 0..AXIS_EXPO_MAX, curve = x^(1 + expo)
+    uint8_t limitPct;  // 0..100, output scale
+    bool invert;
+};
+
+template <uint8_t N, uint8_t Features = AXIS_FEAT_ALL>
+class AxisBatch
+{
+public:
+    static const uint8_t kAxes = N;
+
+    // Same fallbacks as the stick calibration: a degenerate range becomes
+    // 0..adcMax and an out-of-range center moves to the middle.
+    void setAxis(uint8_t i, const AxisParams &p)
+    {
+        if (i >= N)
+            return;
+
+        int32_t calMin = p.calMin;
+        int32_t calMax = p.calMax;
+        int32_t calCenter = p.calCenter;
+        if (calMax > p.adcMax)
+            calMax = p.adcMax;
+        if (calMax <= calMin + 2)
+        {
+            calMin = 0;
+            calMax = p.adcMax;
+        }
+        if (calCenter < calMin || calCenter > calMax)
+            calCenter = (calMin + calMax) / 2;
+
+        int32_t sPos = calMax - calCenter;
+        int32_t sNeg = calCenter - calMin;
+        if (sPos < 1)
+            sPos = 1;
+        if (sNeg < 1)
+            sNeg = 1;
+
+        const int32_t dz = (Features & AXIS_FEAT_DEADZONE) ? p.deadzone : 0;
+
+        adcMax[i] = p.adcMax;
+        invert[i] = p.invert ? 1 : 0;
+        center[i] = (int16_t)calCenter;
+        deadzone[i] = (uint16_t)dz;
+        spanPos[i] = (uint16_t)sPos;
+        spanNeg[i] = (uint16_t)sNeg;
+        gainPos[i] = sideGain(sPos, dz);
+        gainNeg[i] = sideGain(sNeg, dz);
+
+        const uint8_t pct = (p.limitPct > 100) ? 100 : p.limitPct;
+        limit[i] = (uint16_t)(((uint32_t)pct * AXIS_ONE_Q15 + 50) / 100);
+
+        if (Features & AXIS_FEAT_EXPO)
+        {
+            float e = p.expo;
+            if (e < 0.0f)
+                e = 0.0f;
+            if (e > AXIS_EXPO_MAX)
+                e = AXIS_EXPO_MAX;
+            for (uint8_t k = 0; k <= AXIS_CURVE_SEGMENTS; ++k)
+            {
+                const float x = (float)k / (float)AXIS_CURVE_SEGMENTS;
+                const float y = powf(x, 1.0f + e) * (float)AXIS_OUT_MAX;
+                curve[i][k] = (int16_t)(y + 0.5f);
+            }
+        }
+    }
+
+    // raw[N] in, out[N] = signed Q15 (+-AXIS_OUT_MAX)
+    void process(const uint16_t *raw, int16_t *out) const
+    {
+        for (uint8_t i = 0; i < N; ++i)
+            out[i] = processOne(i, raw[i]);
+    }
+
+    int16_t processOne(uint8_t i, uint16_t rawIn) const
+    {
+        int32_t raw = (rawIn > adcMax[i]) ? adcMax[i] : rawIn;
+        if ((Features & AXIS_FEAT_INVERT) && invert[i])
+            raw = adcMax[i] - raw;
+
+        const int32_t c = raw - center[i];
+        const bool neg = c < 0;
+        uint32_t a = (uint32_t)(neg ? -c : c);
+        const uint32_t span = neg ? spanNeg[i] : spanPos[i];
+        const uint32_t dz = deadzone[i];
+
+        if ((Features & AXIS_FEAT_DEADZONE) && (a <= dz || span <= dz))
+            return 0;
+        if (a > span)
+            a = span;
+
+        // (a - dz) <= (span - dz), so the product stays below 2^31
+        const uint32_t gain = neg ? gainNeg[i] : gainPos[i];
+        uint32_t norm = ((a - dz) * gain + 0x8000u) >> 16;
+        if (norm > (uint32_t)AXIS_ONE_Q15)
+            norm = AXIS_ONE_Q15;
+
+        int32_t y;
+        if (Features & AXIS_FEAT_EXPO)
+        {
+            const uint32_t k = norm >> AXIS_CURVE_SHIFT;
+            if (k >= AXIS_CURVE_SEGMENTS)
+            {
+                y = curve[i][AXIS_CURVE_SEGMENTS];
+            }
+            else
+            {
+                const int32_t y0 = curve[i][k];
+                const int32_t y1 = curve[i][k + 1];
+                const int32_t frac = (int32_t)(norm & ((1u << AXIS_CURVE_SHIFT) - 1));
+                y = y0 + (((y1 - y0) * frac + (1L << (AXIS_CURVE_SHIFT - 1))) >> AXIS_CURVE_SHIFT);
+            }
+        }
+        else
+        {
+            y = (int32_t)norm;
+        }
+
+        if (Features & AXIS_FEAT_LIMIT)
+            y = (y * (int32_t)limit[i] + 0x4000) >> 15;
+
+        if (y > AXIS_OUT_MAX)
+            y = AXIS_OUT_MAX;
+        return (int16_t)(neg ? -y : y);
+    }
+
+private:
+    // Q16 scale from deadzone-relative counts to Q15: 1.0 at the span end
+    static uint32_t sideGain(int32_t span, int32_t dz)
+    {
+        if (span <= dz)
+            return 0;
+        const uint32_t d = (uint32_t)(span - dz);
+        return (((uint32_t)AXIS_ONE_Q15 << 16) + d / 2) / d;
+    }
+
+    uint16_t adcMax[N] = {};
+    uint8_t invert[N] = {};
+    int16_t center[N] = {};
+    uint16_t deadzone[N] = {};
+    uint16_t spanPos[N] = {};
+    uint16_t spanNeg[N] = {};
+    uint32_t gainPos[N] = {};
+    uint32_t gainNeg[N] = {};
+    uint16_t limit[N] = {};
+    int16_t curve[(Features & AXIS_FEAT_EXPO) ? N : 1][AXIS_CURVE_SEGMENTS + 1] = {};
+};
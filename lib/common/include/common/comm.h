@@ -1,9 +1,58 @@
 #pragma once
 // #include "ide_compat.h"
+#ifdef ARDUINO
 #include <Arduino.h>
+#endif
 #include <stdint.h>
 
 
+/*
+ * ===== Channel values =====
+ *
+ * Channels are 11-bit (like SBUS/CRSF): COMM_CH_CENTER is neutral,
+ * COMM_CH_MIN / COMM_CH_MAX are full deflection. Switches use MIN/MAX.
+ */
+#define COMM_MAX_CHANNELS 16
+#define COMM_CH_MIN 1
+#define COMM_CH_CENTER 1024
+#define COMM_CH_MAX 2047
+#define COMM_CH_SPAN 1023 // COMM_CH_MAX - COMM_CH_CENTER
+#define COMM_CH_CUT 0     // no signal: output stage stops pulses on this channel
+
+// Default channel map used by the controller
+enum CommChannelIndex : uint8_t
+{
+    COMM_CH_LX = 0, // Left stick X
+    COMM_CH_LY,     // Left stick Y
+    COMM_CH_RX,     // Right stick X
+    COMM_CH_RY,     // Right stick Y
+    COMM_CH_AUX_JL, // Left stick button
+    COMM_CH_AUX_JR, // Right stick button
+    COMM_CH_AUX_F1, // F1 button
+    COMM_CH_AUX_F2, // F2 button
+    COMM_CH_DEFAULT_COUNT
+};
+
+/*
+ * Channel value -> -100..100 percent, integer only (safe on AVR).
+ */
+static inline int8_t commChannelToPct(uint16_t v)
+{
+    const int32_t d = (int32_t)v - COMM_CH_CENTER;
+    const int32_t half = COMM_CH_SPAN / 2;
+    int32_t pct = (d * 100 + ((d >= 0) ? half : -half)) / COMM_CH_SPAN;
+    if (pct > 100)
+        pct = 100;
+    if (pct < -100)
+        pct = -100;
+    return (int8_t)pct;
+}
+
+static inline bool commChannelIsHigh(uint16_t v)
+{
+    return v > COMM_CH_CENTER;
+}
+
 /*
  * ===== Application-level communication frame =====
  *
@@ -12,48 +61,223 @@
  *
  * Note:
  * - Control values are sent from controller to receiver.
- * - Telemetry (battery) is sent back from receiver to controller
- *   via NRF24 ACK payload.
+ *   Only the first channelCount channels go on air (bit-packed,
+ *   dynamic payload length).
+ * - Telemetry is sent back from receiver to controller via NRF24
+ *   ACK payload, see common/telemetry.h.
  */
 struct CommFrame
 {
-    int8_t lx;   // -100..100  Left stick X
-    int8_t ly;   // -100..100  Left stick Y
-    int8_t rx;   // -100..100  Right stick X
-    int8_t ry;   // -100..100  Right stick Y
-    uint8_t joyButtons; // bit0=JL, bit1=JR
+    uint16_t ch[COMM_MAX_CHANNELS]; // 11-bit channel values
+    uint8_t channelCount;           // channels in use, 1..COMM_MAX_CHANNELS
+};
+
+// Telemetry bytes carried by one ACK payload
+#define COMM_ACK_TELEMETRY_MAX 29
+
+/*
+ * ===== Failsafe configuration =====
+ *
+ * Owned by the controller and pushed to the receiver in dedicated
+ * frames (split into chunks that fit the profile payload). The receiver
+ * applies it once missedPeriods control frames in a row did not arrive.
+ */
+enum class CommFailsafeMode : uint8_t
+{
+    Hold = 0, // keep the last received value
+    Preset,   // go to value[]
+    Cut,      // output COMM_CH_CUT (no pulses)
+    Count
+};
 
-    uint8_t battPct;  // 0..100 receiver battery state of charge
+struct CommFailsafeConfig
+{
+    uint8_t missedPeriods;                 // frame periods without data before failsafe, 1..255
+    uint8_t channelCount;                  // channels configured, 1..COMM_MAX_CHANNELS
+    CommFailsafeMode mode[COMM_MAX_CHANNELS];
+    uint16_t value[COMM_MAX_CHANNELS];     // preset values (11-bit)
 };
 
+/*
+ * ===== Link profiles =====
+ *
+ * A link profile bundles every radio parameter that controller and
+ * receiver must agree on (data rate, auto-retransmit, payload size)
+ * together with the controller TX cadence.
+ *
+ * The profile index is shared by both sides, so keep the order stable.
+ */
+enum class CommLinkProfile : uint8_t
+{
+    Robust50 = 0, // 50 Hz  @ 250 kbps, longest range
+    Fast250,      // 250 Hz @ 1 Mbps
+    Race500,      // 500 Hz @ 2 Mbps, lowest latency
+    Count
+};
+
+struct CommLinkProfileInfo
+{
+    const char *name;    // short UI label
+    uint8_t dataRate;    // rf24_datarate_e
+    uint8_t retryDelay;  // auto-retransmit delay, (n + 1) * 250 us
+    uint8_t retryCount;  // auto-retransmit count, 0..15
+    uint8_t payloadSize; // max uplink payload in bytes (limits channel count)
+    uint16_t rateHz;     // TX frame rate
+    uint32_t txPeriodUs; // TX cadence, 1e6 / rateHz
+};
+
+/*
+ * Returns parameters of the given profile.
+ * Out-of-range values fall back to CommLinkProfile::Robust50.
+ */
+const CommLinkProfileInfo &commGetLinkProfileInfo(CommLinkProfile profile);
+
+/*
+ * Applies a link profile to the radio (may be called before commInit,
+ * then it only selects the profile used by commInit).
+ *
+ * Returns false for an unknown profile.
+ */
+bool commSetLinkProfile(CommLinkProfile profile);
+CommLinkProfile commGetLinkProfile();
+
+/*
+ * ===== Frequency hopping =====
+ *
+ * With NRF_FHSS_ENABLED the controller sends every frame on the next
+ * channel of a hop sequence derived from the pipe address, and the
+ * receiver follows it. The channel passed to commInit() is then unused.
+ *
+ * COMM_HOP_COUNT is prime so that, with time slots, every slot comes
+ * around on every channel.
+ */
+#define COMM_HOP_COUNT 19
+
+// Current RF channel (0..125)
+uint8_t commGetChannel();
+
 /*
  * ===== Radio initialization =====
  *
  * cePin / csnPin : NRF24 control pins
- * channel        : RF channel (0..125, e.g. 76)
+ * channel        : RF channel (0..125, e.g. 76) when hopping is disabled
  * address        : 5-byte pipe address (must match on TX and RX)
+ * profile        : initial link profile (must match on TX and RX)
  *
  * Returns true on successful radio initialization.
  */
 bool commInit(uint8_t cePin,
               uint8_t csnPin,
               uint8_t channel,
-              const uint8_t address[5]);
+              const uint8_t address[5],
+              CommLinkProfile profile = CommLinkProfile::Robust50);
+
+/*
+ * ===== Addressing and bind =====
+ *
+ * Each controller/receiver pair uses its own pipe address (which also
+ * seeds the hop sequence). Addresses are handed out in bind mode: both
+ * sides switch to a well-known address on COMM_BIND_CHANNEL at minimum
+ * PA level, the controller offers the address with commQueueBind() and
+ * the receiver picks it up with commTakeBind().
+ */
+#define COMM_BIND_CHANNEL 83 // outside the hop grid (2..77)
+
+/*
+ * ===== Time slots =====
+ *
+ * One controller can serve up to COMM_MAX_SLOTS receivers. Each link
+ * profile period is one tick; tick k goes to slot k % slot count, so
+ * every receiver gets a frame every slot count periods. The hop
+ * sequence advances once per tick and is shared by the receivers of
+ * one controller (see commSetAddress()), so they hop in lockstep.
+ * Receivers need no configuration: they measure their frame spacing.
+ */
+#define COMM_MAX_SLOTS 5
+
+// Switches to another pair address at runtime (hop sequence follows).
+// Byte 0 identifies the receiver, bytes 1..4 the controller and seed the hop sequence.
+bool commSetAddress(const uint8_t address[5]);
+void commGetAddress(uint8_t address[5]);
+
+// Enters / leaves bind mode; leaving restores the pair address and profile.
+bool commSetBindMode(bool enabled);
+bool commIsBindMode();
 
 /*
  * ===== Controller-side API (TX) =====
+ *
+ * Transmission is asynchronous: the radio stays in TX mode, a frame is
+ * queued with commQueueFrame() and its completion (ACK or max retries)
+ * is collected later with commPollTx(). Neither call waits for the air.
  */
 #ifdef ROLE_CONTROLLER
 
+enum class CommTxStatus : uint8_t
+{
+    Idle = 0, // nothing in flight
+    Pending,  // frame queued, waiting for TX_DS / MAX_RT
+    Acked,    // frame acknowledged by receiver
+    Failed    // all retries used, frame dropped
+};
+
+// Per-frame link diagnostics, filled on Acked / Failed
+struct CommTxInfo
+{
+    uint8_t retries;  // auto-retransmits used (ARC from OBSERVE_TX)
+    bool carrier;     // RPD: ACK received above -64 dBm
+    bool ackPayload;  // ACK carried a telemetry payload
+    uint8_t rxFrames; // receiver's rolling received-frame counter (with ackPayload)
+    uint32_t rttUs;   // queue -> completion seen by commPollTx()
+
+    uint8_t ackSeq;         // ACK payload sequence number (with ackPayload)
+    uint16_t ackPrevWaitUs; // FIFO wait of the previous payload, 0xFFFF = flushed as stale
+
+    uint8_t telemetryLen;                        // TLV bytes (with ackPayload)
+    uint8_t telemetry[COMM_ACK_TELEMETRY_MAX];   // decode with telemetryDecode()
+};
+
 /*
- * Sends control frame to receiver.
+ * Queues control frame for transmission and returns immediately.
+ * Channels beyond what fits the profile payload size are not sent.
  *
- * If rxAck is not nullptr, telemetry received via ACK payload
- * is written back into rxAck battery fields.
+ * Returns false if the radio is down or the previous frame is still
+ * in flight (call commPollTx() first).
+ */
+bool commQueueFrame(const CommFrame &tx);
+
+/*
+ * Services the TX pipeline. Uses the IRQ line when NRF_IRQ_PIN is
+ * routed, otherwise polls the STATUS register.
+ *
+ * Returns Acked / Failed exactly once per queued frame, Pending while
+ * the frame is in flight and Idle when nothing was queued.
  *
- * Returns true if the packet was acknowledged by receiver.
+ * On Acked / Failed, if info is not nullptr, it receives link diagnostics
+ * and the telemetry items carried by the ACK payload.
+ */
+CommTxStatus commPollTx(CommTxInfo *info /* may be nullptr */);
+
+/*
+ * Queues the next chunk of the failsafe configuration instead of a
+ * control frame; successive calls rotate through all channels.
+ * Completion is collected with commPollTx() like any other frame.
+ */
+bool commQueueFailsafe(const CommFailsafeConfig &cfg);
+
+/*
+ * Bind mode only: queues a bind offer carrying the pair address and
+ * model id. An Acked completion means the receiver got it.
  */
-bool commSendFrame(const CommFrame &tx, CommFrame *rxAck /* may be nullptr */);
+bool commQueueBind(const uint8_t address[5], uint8_t modelId);
+
+// Time slots: pair address of every slot, and the slot the next frame goes to.
+// Select fails while a frame is in flight.
+bool commSetSlotAddress(uint8_t slot, const uint8_t address[5]);
+bool commSelectSlot(uint8_t slot);
+
+// A tick passed without a frame: keep the hop sequence on time.
+void commSkipHop();
 
 #endif // ROLE_CONTROLLER
 
@@ -63,22 +287,65 @@ bool commSendFrame(const CommFrame &tx, CommFrame *rxAck /* may be nullptr */);
 #ifdef ROLE_RECEIVER
 
 /*
- * Updates ACK payload with telemetry data (battery).
+ * Queues the next ACK payload: receiver frame counter plus the next
+ * round-robin slice of telemetry items (set with telemetrySet()).
  *
  * This payload will be attached to the next received control packet
- * and sent back automatically to the controller.
+ * and sent back automatically to the controller. Only one payload is
+ * kept in the FIFO: while it is pending the call does nothing, and a
+ * payload that no frame picked up within two periods is flushed and
+ * rebuilt. Safe to call every loop.
  *
- * Returns true if ACK payload was successfully queued.
+ * Returns false if the radio is down or the payload could not be written.
  */
-bool commSendFrame(const CommFrame &tx);
+bool commSendTelemetry();
+
+// Receiver-side counters since the previous call
+struct CommRxStats
+{
+    uint16_t frames;  // valid control frames
+    uint16_t carrier; // of those, received above -64 dBm (RPD)
+};
+
+void commRxTakeStats(CommRxStats &out);
 
 /*
  * Polls for incoming control frames from controller.
  *
  * outFrame is filled with the most recent received packet.
+ * Also drives the hop follower, so call it frequently.
+ *
+ * With NRF_IRQ_PIN >= 0 the RX FIFO is drained from the IRQ handler
+ * into a double buffer, so frames do not wait for the main loop;
+ * this call only hands over the freshest one. arrivalUs (optional)
+ * receives its micros() timestamp.
  *
  * Returns true if at least one new packet was read.
  */
-bool commPollFrame(CommFrame &outFrame);
+bool commPollFrame(CommFrame &outFrame, uint32_t *arrivalUs = nullptr);
+
+/*
+ * Merges the failsafe chunk received since the previous call into cfg.
+ * Returns true if cfg was updated.
+ */
+bool commTakeFailsafeConfig(CommFailsafeConfig &cfg);
+
+/*
+ * Bind mode only: returns true once a bind offer has been received.
+ * commPollFrame() must be called to service the radio.
+ */
+bool commTakeBind(uint8_t address[5], uint8_t &modelId);
+
+/*
+ * True while the receiver follows the controller hop sequence,
+ * false during sync acquisition (parked on one channel).
+ */
+bool commRxHopSynced();
+
+/*
+ * Time between this receiver's frames: the link profile period times
+ * the controller's time slots, as measured (profile period until known).
+ */
+uint32_t commRxFrameIntervalUs();
 
 #endif // ROLE_RECEIVER
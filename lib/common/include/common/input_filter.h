@@ -0,0 +1,95 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * ===== Input filters =====
+ *
+ * Noise filters for sampled inputs (stick axes, light sensor, battery).
+ * One InputFilter instance filters one signal, fed once per sample at a
+ * known rate. The per-sample path is integer only; float is used in
+ * configure() for coefficients and the group delay, so the module runs on
+ * the ESP32 controller and the AVR receivers alike.
+ *
+ * Types (strength 1..INPUT_FILTER_STRENGTH_MAX, higher = smoother/slower):
+ * - Ema: one pole, alpha = 1 / 2^strength.
+ * - Median: 2 * strength + 1 taps; removes spikes, keeps steps sharp.
+ * - Biquad: 2nd-order Butterworth low-pass, cutoff from a table,
+ *   capped at 0.4 of the sample rate.
+ * - OneEuro: 1 euro filter. One pole whose cutoff rises with the signal
+ *   speed: heavy smoothing at rest, little lag on fast moves. Strength
+ *   picks the rest cutoff; beta (INPUT_FILTER_EURO_BETA_Q16) is tuned for
+ *   12-bit ADC counts.
+ *
+ * groupDelayUs() is the delay at low frequencies (rest for OneEuro) at the
+ * configured sample rate: what the filter adds to input-to-output latency.
+ */
+
+enum class InputFilterType : uint8_t
+{
+    Off = 0,
+    Ema,
+    Median,
+    Biquad,
+    OneEuro,
+    Count
+};
+
+#define INPUT_FILTER_STRENGTH_MAX 5
+#define INPUT_FILTER_MEDIAN_MAX (2 * INPUT_FILTER_STRENGTH_MAX + 1)
+
+// 1 euro speed coefficient: Hz of extra cutoff per count/s, Q16 (0.005)
+#define INPUT_FILTER_EURO_BETA_Q16 328
+// Cutoff of the 1 euro speed estimate, Hz
+#define INPUT_FILTER_EURO_DCUTOFF_HZ 1.0f
+
+struct InputFilterConfig
+{
+    InputFilterType type;
+    uint8_t strength; // 1..INPUT_FILTER_STRENGTH_MAX
+};
+
+class InputFilter
+{
+public:
+    // Out-of-range values fall back to Off / strength 1. Resets the state.
+    void configure(const InputFilterConfig &cfg, uint32_t sampleRateHz);
+    const InputFilterConfig &config() const { return cfg; }
+
+    // Forget the history: the next sample passes through as is
+    void reset();
+
+    uint16_t update(uint16_t x);
+
+    uint32_t groupDelayUs() const { return delayUs; }
+
+private:
+    InputFilterConfig cfg{InputFilterType::Off, 1};
+    uint32_t delayUs = 0;
+    bool primed = false;
+
+    // Ema: state in Q8
+    int32_t ema = 0;
+
+    // Median: ring of the last taps
+    uint16_t ring[INPUT_FILTER_MEDIAN_MAX] = {};
+    uint8_t taps = 3;
+    uint8_t ringPos = 0;
+    uint8_t ringCount = 0;
+
+    // Biquad: direct form I, signal in Q4, coefficients in Q28 (a0 = 1)
+    int32_t b0 = 0, b1 = 0, b2 = 0, a1 = 0, a2 = 0;
+    int32_t x1 = 0, x2 = 0, y1 = 0, y2 = 0;
+
+    // OneEuro: signal in Q4, speed in Q4 counts/s, cutoffs in Q8 Hz
+    uint32_t rateHz = 50;
+    uint32_t omegaQ16 = 0;  // 2 * pi / rate, Q16
+    uint32_t minCutQ8 = 0;  // cutoff at rest
+    uint32_t dAlphaQ16 = 0; // speed estimate smoothing
+    int32_t xHat = 0;
+    int32_t dxHat = 0;
+
+    uint16_t updateMedian(uint16_t x);
+    uint16_t updateBiquad(uint16_t x);
+    uint16_t updateOneEuro(uint16_t x);
+    uint32_t euroAlphaQ16(uint32_t cutQ8) const;
+};
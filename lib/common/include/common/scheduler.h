@@ -0,0 +1,70 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * ===== Cooperative scheduler =====
+ *
+ * Fixed-rate tasks for a super loop: the controller UI task and the
+ * receiver loop() call schedRun() on every pass. A task is a plain
+ * function with a period and a phase in microseconds and a priority.
+ *
+ * - Releases stay on the grid (phase + n * period): a late start does not
+ *   shift later releases. Releases that could not start before the next
+ *   one are dropped and counted as skipped, never run in a burst.
+ * - Among the tasks due in one schedRun() pass, higher priority runs
+ *   first; every task runs at most once per pass. Period 0 = every pass.
+ * - Deadline = the next release. A run that finishes later is a miss.
+ *
+ * Per task it tracks execution time and start jitter (lateness against
+ * the release), both average (1/8 EMA) and worst, saturated to 16 bits.
+ * Time comes from micros() and wraps safely; one table per firmware,
+ * integer only, so it runs on the ESP32 and the AVR receivers alike.
+ * Not thread-safe: add, run and query from one task.
+ */
+
+#ifndef SCHED_MAX_TASKS
+#ifdef __AVR__
+#define SCHED_MAX_TASKS 6
+#else
+#define SCHED_MAX_TASKS 12
+#endif
+#endif
+#if SCHED_MAX_TASKS > 32
+#error "SCHED_MAX_TASKS: at most 32 tasks (one bit each per pass)"
+#endif
+
+typedef void (*SchedFn)();
+
+struct SchedStats
+{
+    const char *name;
+    uint32_t periodUs;
+    uint32_t runs;
+    uint16_t execAvgUs;
+    uint16_t execMaxUs;
+    uint16_t jitterAvgUs; // start - release
+    uint16_t jitterMaxUs;
+    uint16_t missed;  // runs that finished after their deadline
+    uint16_t skipped; // releases dropped because the task was still late
+};
+
+/*
+ * Registers a task; the first release is phaseUs after the call.
+ * Returns the task id, or -1 if the table is full.
+ */
+int8_t schedAdd(const char *name, SchedFn fn, uint32_t periodUs, uint32_t phaseUs, uint8_t priority);
+
+// New period from the next release on
+void schedSetPeriod(int8_t id, uint32_t periodUs);
+
+/*
+ * Runs the tasks that are due. Returns the microseconds until the next
+ * release (0 if a period-0 task exists or a task is already due again).
+ */
+uint32_t schedRun();
+
+uint8_t schedCount();
+bool schedGetStats(int8_t id, SchedStats &out);
+
+// Clears counters and worst cases of all tasks (e.g. after each report)
+void schedResetStats();
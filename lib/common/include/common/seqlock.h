@@ -0,0 +1,51 @@
+#pragma once
+#include <stdint.h>
+#include <string.h>
+#include <atomic>
+
+/*
+ * ===== Seqlock =====
+ *
+ * Latest-value hand-over of a small struct from one writer to any number
+ * of readers on other cores or tasks. The writer never waits: it bumps
+ * the sequence to odd, copies, and bumps it back to even. A reader copies
+ * and retries while the sequence was odd or moved during the copy, so it
+ * always gets one whole value, never a mix of two writes.
+ *
+ * Use it for state that is overwritten every tick (input snapshot,
+ * statistics) where only the newest value matters. T must be trivially
+ * copyable. Needs <atomic>: controller (ESP32) only.
+ */
+
+template <typename T>
+class Seqlock
+{
+public:
+    // Single writer
+    void write(const T &v)
+    {
+        const uint32_t s = seq.load(std::memory_order_relaxed);
+        seq.store(s + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        memcpy(&value, &v, sizeof(T));
+        seq.store(s + 2, std::memory_order_release);
+    }
+
+    T read() const
+    {
+        T v;
+        uint32_t s0, s1;
+        do
+        {
+            s0 = seq.load(std::memory_order_acquire);
+            memcpy(&v, &value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            s1 = seq.load(std::memory_order_relaxed);
+        } while ((s0 & 1u) != 0 || s0 != s1);
+        return v;
+    }
+
+private:
+    std::atomic<uint32_t> seq{0};
+    T value{};
+};
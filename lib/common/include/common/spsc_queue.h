@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+#include <atomic>
+
+/*
+ * ===== SPSC queue =====
+ *
+ * Bounded FIFO between one producer and one consumer, typically on
+ * different cores. Neither side locks or waits: push() fails when the
+ * queue is full, pop() when it is empty. Several producers are fine as
+ * long as they are serialised by the same lock (the control lock on the
+ * controller), which makes them one producer at a time.
+ *
+ * Use it for event streams where every item counts (per-frame results
+ * aggregated elsewhere). N must be a power of two; one slot stays free.
+ * Needs <atomic>: controller (ESP32) only.
+ */
+
+template <typename T, uint16_t N>
+class SpscQueue
+{
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "N must be a power of two");
+
+public:
+    // Producer
+    bool push(const T &v)
+    {
+        const uint16_t h = head.load(std::memory_order_relaxed);
+        const uint16_t next = (uint16_t)((h + 1) & (N - 1));
+        if (next == tail.load(std::memory_order_acquire))
+            return false;
+        items[h] = v;
+        head.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer
+    bool pop(T &v)
+    {
+        const uint16_t t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return false;
+        v = items[t];
+        tail.store((uint16_t)((t + 1) & (N - 1)), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const
+    {
+        return tail.load(std::memory_order_acquire) == head.load(std::memory_order_acquire);
+    }
+
+private:
+    T items[N];
+    std::atomic<uint16_t> head{0};
+    std::atomic<uint16_t> tail{0};
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * ===== Multiplexed telemetry (receiver -> controller) =====
+ *
+ * Telemetry travels in NRF24 ACK payloads as a list of TLV items.
+ * Each item is one tag byte followed by 1..4 value bytes (little endian):
+ *
+ *   tag = (id << 2) | (len - 1)     id: 1..63, len: 1..4
+ *
+ * The receiver keeps the latest value of every item and a scheduler
+ * round-robins them across successive ACK payloads, so any number of
+ * sensors share the downlink without extra uplink airtime.
+ */
+enum class TelemetryId : uint8_t
+{
+    None = 0,
+    RxBattPct = 1,   // u8  receiver battery 0..100 %
+    RxBattMv = 2,    // u16 receiver battery in mV
+    RxLoopHz = 3,    // u16 receiver main loop iterations per second
+    RxFrameRate = 4, // u16 control frames received per second
+    RxRssi = 5,      // u8  frames received above -64 dBm (RPD), 0..100 %
+    RxFsLatencyMs = 6, // u16 last frame -> failsafe declared, latest link loss
+    RxFsCount = 7,   // u16 failsafe activations since receiver start
+    RxModelId = 8,   // u8  model id the receiver is bound to
+    Custom = 32,     // first id free for receiver-specific sensors
+    Max = 63
+};
+
+#define TELEMETRY_MAX_ITEMS 12
+#define TELEMETRY_ID_COUNT 64
+
+/*
+ * ===== Receiver side: scheduler =====
+ */
+
+/*
+ * Updates (or registers) an item. len is the value width on air, 1..4 bytes.
+ * Returns false if the id is invalid or the item table is full.
+ */
+bool telemetrySet(TelemetryId id, uint32_t value, uint8_t len);
+
+/*
+ * Packs as many items as fit into dst, starting after the item that was
+ * sent last (round-robin). Returns the number of bytes written.
+ */
+uint8_t telemetryPack(uint8_t *dst, uint8_t capacity);
+
+/*
+ * ===== Controller side: decoder =====
+ */
+typedef void (*TelemetryItemFn)(TelemetryId id, uint32_t value, void *ctx);
+
+/*
+ * Walks TLV items in src and calls fn for each complete one.
+ * Returns the number of items decoded; stops at the first truncated item.
+ */
+uint8_t telemetryDecode(const uint8_t *src, uint8_t len, TelemetryItemFn fn, void *ctx);
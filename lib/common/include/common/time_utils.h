@@ -10,6 +10,8 @@
  *       // code executed every 100 ms
  *   }
  *
- * lastTick must be preserved between calls.
+ * lastTick must be preserved between calls. Millisecond granularity and
+ * no overrun reporting: fine for UI refresh throttles; periodic work goes
+ * into the scheduler (common/scheduler.h).
  */
 bool everyMs(uint32_t interval, uint32_t &lastTick);
@@ -5,6 +5,7 @@
 #endif
 
 #include <common/comm.h>
+#include <common/telemetry.h>
 
 #include <RF24.h>
 #include <SPI.h>
@@ -25,38 +26,513 @@ static uint8_t gAddr[5] = {0};
 /*
  * On-air packet formats (packed).
  * These are NOT exposed outside this file.
+ *
+ * Uplink (dynamic payload length):
+ *   channels: PktHeader | channel count | channels, 11 bits each, LSB first
+ *   failsafe: PktHeader | first<<4 | count-1 | missed periods |
+ *             modes, 2 bits each | preset values, 11 bits each
+ *   bind:     PktHeader | address[5] | model id   (bind channel/address only)
  */
 #pragma pack(push, 1)
-struct TxPkt
+struct PktHeader
 {
-    int8_t lx;
-    int8_t ly;
-    int8_t rx;
-    int8_t ry;
-    uint8_t joyButtons;
+    uint8_t verType; // bits 7..4 version, bits 3..0 frame type
+    uint8_t hop;     // index in hop sequence of the channel this frame is sent on
 };
 
-struct AckPkt
+/*
+ * Downlink (ACK payload, dynamic length):
+ *   AckHeader | telemetry TLV items (see common/telemetry.h)
+ */
+struct AckHeader
 {
-    uint8_t battPct; // 0..100 telemetry value
-    uint8_t flags; // reserved for future use
+    uint8_t rxFrames;  // rolling count of control frames received (wraps)
+    uint8_t seq;       // payload sequence number (wraps)
+    uint8_t prevWait;  // time the previous payload waited in the FIFO, 100 us units (255 = stale)
 };
 #pragma pack(pop)
 
-static_assert(sizeof(TxPkt) == 5, "TxPkt size must be exactly 5 bytes");
-static_assert(sizeof(AckPkt) == 2, "AckPkt size must be exactly 2 bytes");
+static const uint8_t PKT_VERSION = 1;
+static const uint8_t PKT_TYPE_CHANNELS = 0;
+static const uint8_t PKT_TYPE_FAILSAFE = 1;
+static const uint8_t PKT_TYPE_BIND = 2;
+static const uint8_t PKT_MAX_SIZE = 32;
+static const uint8_t CH_BITS = 11;
+static const uint16_t CH_MASK = (1u << CH_BITS) - 1u;
+
+static_assert(sizeof(PktHeader) == 2, "PktHeader size must be exactly 2 bytes");
+static_assert(sizeof(AckHeader) + COMM_ACK_TELEMETRY_MAX == 32, "ACK payload must fill one nRF24 payload");
+
+static inline uint8_t packedChannelBytes(uint8_t count)
+{
+    return (uint8_t)(((uint16_t)count * CH_BITS + 7u) / 8u);
+}
+
+static_assert(sizeof(PktHeader) + 1 + ((COMM_MAX_CHANNELS * 11 + 7) / 8) <= 32,
+              "Full channel frame must fit one nRF24 payload");
+
+static uint8_t packChannels(const uint16_t *ch, uint8_t count, uint8_t *dst)
+{
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+    uint8_t len = 0;
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        acc |= (uint32_t)(ch[i] & CH_MASK) << bits;
+        bits += CH_BITS;
+        while (bits >= 8)
+        {
+            dst[len++] = (uint8_t)acc;
+            acc >>= 8;
+            bits -= 8;
+        }
+    }
+    if (bits > 0)
+        dst[len++] = (uint8_t)acc;
+    return len;
+}
+
+static inline uint8_t packedModeBytes(uint8_t count)
+{
+    return (uint8_t)((count + 3u) / 4u);
+}
+
+static void unpackChannels(const uint8_t *src, uint8_t count, uint16_t *ch)
+{
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        while (bits < CH_BITS)
+        {
+            acc |= (uint32_t)(*src++) << bits;
+            bits += 8;
+        }
+        ch[i] = (uint16_t)(acc & CH_MASK);
+        acc >>= CH_BITS;
+        bits -= CH_BITS;
+    }
+}
+
+/*
+ * Link profile table, indexed by CommLinkProfile.
+ *
+ * Retries are sized so that the worst case (all retransmits used)
+ * still fits inside one TX period of the profile, and the retransmit
+ * delay is long enough for a full 32-byte ACK payload at that rate.
+ */
+static const CommLinkProfileInfo kLinkProfiles[] = {
+    // name      rate          ARD ARC payload  Hz   period us
+    {"ROBUST", RF24_250KBPS, 5, 5, 32, 50, 20000UL}, // 1500 us ARD: full 32 B ACK payload at 250 kbps
+    {"FAST", RF24_1MBPS, 1, 3, 32, 250, 4000UL},
+    {"RACE", RF24_2MBPS, 1, 1, 16, 500, 2000UL},
+};
+
+static_assert(sizeof(kLinkProfiles) / sizeof(kLinkProfiles[0]) == (size_t)CommLinkProfile::Count,
+              "kLinkProfiles must cover every CommLinkProfile");
+static_assert(sizeof(PktHeader) + 1 + ((COMM_CH_DEFAULT_COUNT * 11 + 7) / 8) <= 16,
+              "Default channel map must fit the smallest profile payload");
+
+static CommLinkProfile gProfile = CommLinkProfile::Robust50;
+
+/*
+ * ===== Frequency hopping =====
+ *
+ * The hop sequence is a permutation of COMM_HOP_COUNT channels spaced
+ * 4 MHz apart (2..77, inside the 2400-2483.5 MHz band). Grid offset and
+ * order are derived from address bytes 1..4: every controller hops
+ * through its own sequence, and all receivers bound to one controller
+ * (which differ in byte 0 only) share it, so time slots stay in lockstep.
+ */
+static uint8_t gHopTable[COMM_HOP_COUNT] = {0};
+static uint8_t gHopIdx = 0;
+static uint8_t gFixedChannel = 0;
+
+/*
+ * ===== Bind mode =====
+ *
+ * Well-known address on a channel outside the hop grid, minimum PA
+ * level and the robust profile: only a receiver right next to the
+ * controller picks up the bind packet.
+ */
+static const uint8_t kBindAddr[5] = {'F', 'B', 'I', 'N', 'D'};
+static bool gBindMode = false;
+
+#ifdef ROLE_RECEIVER
+// Hop follower: free-runs at the profile period between received frames
+static const uint8_t HOP_RESYNC_MISSES = 8; // missed dwells before re-acquisition
+static const uint8_t HOP_PARK_LEAD = 2;     // park this many hops ahead of prediction
+static bool gHopSynced = false;
+static bool gDwellGotFrame = false;
+static uint8_t gHopMisses = 0;
+static uint32_t gNextHopUs = 0;
+static uint32_t gParkSinceUs = 0;
+#endif
+
+#ifdef ROLE_CONTROLLER
+// Async TX state
+static const uint32_t TX_TIMEOUT_US = 30000UL; // longer than worst-case retries of any profile
+static bool gTxInFlight = false;
+static uint32_t gTxStartUs = 0;
+
+// Time slots: pair address per receiver, gAddr holds the selected one
+static uint8_t gSlotAddr[COMM_MAX_SLOTS][5];
+static uint8_t gSlot = 0;
+
+#if NRF_IRQ_PIN >= 0
+static volatile bool gIrqPending = false;
+
+static void IRAM_ATTR onRadioIrq()
+{
+    gIrqPending = true;
+}
+#endif
+#endif
+
+#ifdef ROLE_RECEIVER
+// Bind offer received in bind mode: address[5] + model id
+static uint8_t gBindOffer[6];
+static bool gBindOfferValid = false;
+
+// Latest failsafe chunk, merged by commTakeFailsafeConfig()
+static uint8_t gFsPkt[PKT_MAX_SIZE];
+static uint8_t gFsPktLen = 0;
+
+// ACK payload state: at most one payload sits in the TX FIFO at a time
+static uint8_t gRxFrames = 0;
+static CommRxStats gRxStats = {0, 0};
+static bool gAckPending = false;  // payload queued, not yet sent with an ACK
+static uint32_t gAckQueuedUs = 0; // when the pending payload was written
+static uint8_t gAckSeq = 0;
+static uint8_t gAckPrevWait = 0;
+static uint32_t gLastFrameUs = 0;
+static uint32_t gRxIntervalUs = 0; // between own frames: profile period x controller time slots
+static uint8_t gRxIntervalVotes = 0;
+
+/*
+ * Decoded control frames: rxDrain() writes the back buffer and flips,
+ * commPollFrame() copies the front one. gRxSeq changes on every flip,
+ * so a copy torn by the IRQ handler is detected and retried.
+ */
+struct RxFrameBuf
+{
+    CommFrame frame;
+    uint32_t arrivalUs;
+};
+
+static RxFrameBuf gRxBuf[2];
+static volatile uint8_t gRxFront = 0;
+static volatile uint8_t gRxSeq = 0;
+static uint8_t gRxTakenSeq = 0;
+
+#if NRF_IRQ_PIN >= 0
+// Main-loop side of state shared with the IRQ handler; SPI.usingInterrupt()
+// already keeps the handler out of SPI transactions.
+// On AVR only the radio line is masked, so timer interrupts (output
+// engine) keep running; elsewhere all interrupts are held off.
+#if defined(__AVR__)
+static const uint8_t RX_IRQ_EIMSK_BIT = (uint8_t)_BV(digitalPinToInterrupt(NRF_IRQ_PIN));
+
+struct RxIrqLock
+{
+    uint8_t wasEnabled;
+    RxIrqLock()
+    {
+        const uint8_t sreg = SREG;
+        cli();
+        wasEnabled = (uint8_t)(EIMSK & RX_IRQ_EIMSK_BIT);
+        EIMSK &= (uint8_t)~RX_IRQ_EIMSK_BIT;
+        SREG = sreg;
+    }
+    ~RxIrqLock()
+    {
+        const uint8_t sreg = SREG;
+        cli();
+        EIMSK |= wasEnabled;
+        SREG = sreg;
+    }
+};
+#else
+struct RxIrqLock
+{
+    RxIrqLock() { noInterrupts(); }
+    ~RxIrqLock() { interrupts(); }
+};
+#endif
+
+static void onRadioIrq();
+#else
+struct RxIrqLock
+{
+};
+#endif
+#endif
+
+const CommLinkProfileInfo &commGetLinkProfileInfo(CommLinkProfile profile)
+{
+    if ((uint8_t)profile >= (uint8_t)CommLinkProfile::Count)
+        profile = CommLinkProfile::Robust50;
+    return kLinkProfiles[(uint8_t)profile];
+}
+
+CommLinkProfile commGetLinkProfile()
+{
+    return gProfile;
+}
+
+static uint32_t hopSeed(const uint8_t address[5])
+{
+    // FNV-1a over the controller part of the pipe address
+    uint32_t h = 2166136261UL;
+    for (uint8_t i = 1; i < 5; ++i)
+    {
+        h ^= address[i];
+        h *= 16777619UL;
+    }
+    return h ? h : 1UL;
+}
+
+static uint32_t xorshift32(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void buildHopTable(const uint8_t address[5])
+{
+    uint32_t rng = hopSeed(address);
+    const uint8_t offset = (uint8_t)(xorshift32(rng) & 0x03u);
+
+    for (uint8_t i = 0; i < COMM_HOP_COUNT; ++i)
+        gHopTable[i] = (uint8_t)(2u + offset + 4u * i);
+
+    // Fisher-Yates shuffle
+    for (uint8_t i = COMM_HOP_COUNT - 1; i > 0; --i)
+    {
+        const uint8_t j = (uint8_t)(xorshift32(rng) % (uint32_t)(i + 1));
+        const uint8_t t = gHopTable[i];
+        gHopTable[i] = gHopTable[j];
+        gHopTable[j] = t;
+    }
+}
+
+static void tuneHop(uint8_t idx)
+{
+    gHopIdx = (uint8_t)(idx % COMM_HOP_COUNT);
+    if (gBindMode)
+    {
+        gRadio->setChannel(COMM_BIND_CHANNEL);
+        return;
+    }
+#if NRF_FHSS_ENABLED
+    gRadio->setChannel(gHopTable[gHopIdx]);
+#else
+    gRadio->setChannel(gFixedChannel);
+#endif
+}
 
 #ifdef ROLE_RECEIVER
-// Cached ACK payload sent back to controller
-static AckPkt gAck = {0, 0};
+static void hopStartAcquisition(uint8_t parkIdx)
+{
+    gHopSynced = false;
+    gHopMisses = 0;
+    gDwellGotFrame = false;
+    gParkSinceUs = micros();
+    tuneHop(parkIdx);
+}
+
+static void hopOnFrame(uint8_t hop, uint32_t nowUs)
+{
+    // Hop half a period after the frame: the ACK is out, next frame is not due yet
+    gHopSynced = true;
+    gHopMisses = 0;
+    gDwellGotFrame = true;
+    gHopIdx = (uint8_t)(hop % COMM_HOP_COUNT);
+    gNextHopUs = nowUs + commGetLinkProfileInfo(gProfile).txPeriodUs / 2UL;
+}
+
+static void hopService(uint32_t nowUs)
+{
+#if NRF_FHSS_ENABLED
+    const uint32_t periodUs = commGetLinkProfileInfo(gProfile).txPeriodUs;
+
+    if (!gHopSynced)
+    {
+        // Controller visits every channel once per cycle, and with time slots this
+        // receiver's frame lands on it once every slot count cycles (hop count is prime)
+        if (nowUs - gParkSinceUs > periodUs * (uint32_t)(COMM_HOP_COUNT + 1) * COMM_MAX_SLOTS)
+        {
+            gParkSinceUs = nowUs;
+            tuneHop(gHopIdx + 1);
+        }
+        return;
+    }
+
+    if ((int32_t)(nowUs - gNextHopUs) < 0)
+        return;
+
+    gNextHopUs += periodUs;
+    if (gDwellGotFrame)
+        gHopMisses = 0;
+    else
+        gHopMisses++;
+    gDwellGotFrame = false;
+
+    // With time slots only every n-th dwell carries a frame for this receiver
+    const uint32_t slots = (gRxIntervalUs > periodUs) ? gRxIntervalUs / periodUs : 1UL;
+    if (gHopMisses > HOP_RESYNC_MISSES * slots)
+    {
+        // Park slightly ahead of the predicted position for a fast re-sync
+        hopStartAcquisition((uint8_t)(gHopIdx + 1 + HOP_PARK_LEAD));
+        return;
+    }
+
+    tuneHop(gHopIdx + 1);
+#else
+    (void)nowUs;
+#endif
+}
 #endif
 
+uint8_t commGetChannel()
+{
+    if (gBindMode)
+        return COMM_BIND_CHANNEL;
+#if NRF_FHSS_ENABLED
+    return gHopTable[gHopIdx];
+#else
+    return gFixedChannel;
+#endif
+}
+
+/*
+ * Idle radio mode between operations:
+ * - controller stays in TX mode (no CE/PRIM_RX toggling per frame)
+ * - receiver listens on pipe 1
+ */
+static void enterIdleMode()
+{
+#ifdef ROLE_CONTROLLER
+    gRadio->stopListening();
+    gRadio->flush_tx();
+    gTxInFlight = false;
+#else
+    gRadio->startListening();
+    gRadio->flush_tx();
+    gAckPending = false;
+#endif
+}
+
+// Writes profile-dependent registers; radio must be out of RX/TX mode.
+static void applyLinkProfile(const CommLinkProfileInfo &p)
+{
+    gRadio->setDataRate((rf24_datarate_e)p.dataRate);
+    gRadio->setRetries(p.retryDelay, p.retryCount);
+    gRadio->setPayloadSize(p.payloadSize);
+}
+
+bool commSetLinkProfile(CommLinkProfile profile)
+{
+    if ((uint8_t)profile >= (uint8_t)CommLinkProfile::Count)
+        return false;
+
+    gProfile = profile;
+    if (!gRadio || !gRadioOk)
+        return true; // picked up by commInit()
+
+    if (gBindMode)
+        return true; // applied when bind mode ends
+
+#ifdef ROLE_RECEIVER
+    RxIrqLock lock;
+#endif
+    gRadio->stopListening();
+    applyLinkProfile(commGetLinkProfileInfo(profile));
+#ifdef ROLE_RECEIVER
+    hopStartAcquisition(0);
+    gRxIntervalUs = 0; // measured again at the new period
+#endif
+    enterIdleMode();
+    return true;
+}
+
+// Points both pipes at the active address (bind or paired).
+static void openPipes()
+{
+    const uint8_t *addr = gBindMode ? kBindAddr : gAddr;
+    gRadio->openWritingPipe(addr);
+    gRadio->openReadingPipe(1, addr);
+}
+
+bool commSetAddress(const uint8_t address[5])
+{
+    memcpy(gAddr, address, 5);
+#ifdef ROLE_CONTROLLER
+    memcpy(gSlotAddr[gSlot], address, 5);
+#endif
+    buildHopTable(gAddr);
+    if (!gRadio || !gRadioOk || gBindMode)
+        return true; // picked up by commInit() / commSetBindMode(false)
+
+#ifdef ROLE_RECEIVER
+    RxIrqLock lock;
+#endif
+    gRadio->stopListening();
+    openPipes();
+    tuneHop(0);
+#ifdef ROLE_RECEIVER
+    hopStartAcquisition(0);
+#endif
+    enterIdleMode();
+    return true;
+}
+
+void commGetAddress(uint8_t address[5])
+{
+    memcpy(address, gAddr, 5);
+}
+
+bool commSetBindMode(bool enabled)
+{
+    if (!gRadio || !gRadioOk)
+        return false;
+
+#ifdef ROLE_RECEIVER
+    RxIrqLock lock;
+#endif
+    gBindMode = enabled;
+    gRadio->stopListening();
+    gRadio->setPALevel(enabled ? RF24_PA_MIN : NRF_PA_LEVEL);
+    applyLinkProfile(commGetLinkProfileInfo(enabled ? CommLinkProfile::Robust50 : gProfile));
+    openPipes();
+    tuneHop(0);
+#ifdef ROLE_RECEIVER
+    hopStartAcquisition(0);
+#endif
+    enterIdleMode();
+    return true;
+}
+
+bool commIsBindMode()
+{
+    return gBindMode;
+}
+
 bool commInit(uint8_t cePin,
               uint8_t csnPin,
               uint8_t channel,
-              const uint8_t address[5])
+              const uint8_t address[5],
+              CommLinkProfile profile)
 {
     memcpy(gAddr, address, 5);
+    gFixedChannel = channel;
+    buildHopTable(gAddr);
+    if ((uint8_t)profile < (uint8_t)CommLinkProfile::Count)
+        gProfile = profile;
 
     // Allocate RF24 object once
     if (!gRadio)
@@ -82,15 +558,16 @@ bool commInit(uint8_t cePin,
         return false;
     }
 
-    // Stable, short-range configuration
-    gRadio->setChannel(channel);
-    gRadio->setDataRate(RF24_250KBPS);   // most robust
+    // Profile-independent configuration
+    tuneHop(0);
     gRadio->setPALevel(NRF_PA_LEVEL);
     gRadio->setCRCLength(RF24_CRC_16);   // strong CRC
-    gRadio->setRetries(3, 5);            // delay, count
     gRadio->setAutoAck(true);
+    gRadio->enableDynamicPayloads();     // only used channels go on air
     gRadio->enableAckPayload();          // enable telemetry via ACK
-    gRadio->setPayloadSize(sizeof(TxPkt));
+
+    // Data rate, retries, payload size
+    applyLinkProfile(commGetLinkProfileInfo(gProfile));
 
     /*
      * Pipe usage:
@@ -98,11 +575,26 @@ bool commInit(uint8_t cePin,
      * - Reading pipe 1: used by receiver to receive control packets
      *   and to attach ACK payloads
      */
-    gRadio->openWritingPipe(gAddr);
-    gRadio->openReadingPipe(1, gAddr);
+    openPipes();
 
-    // Start in listening mode (safe default)
-    gRadio->startListening();
+#if defined(ROLE_CONTROLLER) && NRF_IRQ_PIN >= 0
+    // TX_DS / MAX_RT / RX_DR all assert IRQ (active low)
+    pinMode(NRF_IRQ_PIN, INPUT_PULLUP);
+    gIrqPending = false;
+    attachInterrupt(digitalPinToInterrupt(NRF_IRQ_PIN), onRadioIrq, FALLING);
+#elif defined(ROLE_RECEIVER) && NRF_IRQ_PIN >= 0
+    // Only RX_DR asserts IRQ; the handler reads the FIFO over SPI, so
+    // SPI transactions in the main loop must keep it masked
+    gRadio->maskIRQ(true, true, false);
+    pinMode(NRF_IRQ_PIN, INPUT_PULLUP);
+    SPI.usingInterrupt(digitalPinToInterrupt(NRF_IRQ_PIN));
+    attachInterrupt(digitalPinToInterrupt(NRF_IRQ_PIN), onRadioIrq, FALLING);
+#endif
+
+#ifdef ROLE_RECEIVER
+    hopStartAcquisition(0);
+#endif
+    enterIdleMode();
 
     gRadioOk = true;
     return true;
@@ -110,68 +602,470 @@ bool commInit(uint8_t cePin,
 
 #ifdef ROLE_CONTROLLER
 
-bool commSendFrame(const CommFrame &tx, CommFrame *rxAck)
+// Failsafe chunk rotation: first channel of the next chunk
+static uint8_t gFsNextCh = 0;
+
+bool commSetSlotAddress(uint8_t slot, const uint8_t address[5])
 {
-    if (!gRadio || !gRadioOk)
+    if (slot >= COMM_MAX_SLOTS)
         return false;
 
-    // Convert application frame to on-air packet
-    TxPkt pkt{tx.lx, tx.ly, tx.rx, tx.ry, tx.joyButtons};
+    memcpy(gSlotAddr[slot], address, 5);
+    if (slot == gSlot)
+        return commSetAddress(address);
+    return true;
+}
 
-    // TX requires radio to stop listening
-    gRadio->stopListening();
-    bool ok = gRadio->write(&pkt, sizeof(pkt));
-    gRadio->startListening();
+bool commSelectSlot(uint8_t slot)
+{
+    if (slot >= COMM_MAX_SLOTS || gTxInFlight)
+        return false;
+    if (slot == gSlot)
+        return true;
+
+    // Same controller part of the address keeps the hop table (receivers bound
+    // before the shared part was introduced get their own sequence)
+    const bool sameHops = memcmp(gAddr + 1, gSlotAddr[slot] + 1, 4) == 0;
+    gSlot = slot;
+    memcpy(gAddr, gSlotAddr[slot], 5);
+    if (!sameHops)
+        buildHopTable(gAddr);
+    if (gRadio && gRadioOk && !gBindMode)
+        gRadio->openWritingPipe(gAddr);
+    return true;
+}
+
+void commSkipHop()
+{
+    gHopIdx = (uint8_t)((gHopIdx + 1) % COMM_HOP_COUNT);
+}
+
+// Puts a built packet on the air on the next hop channel
+static void queuePacket(uint8_t *pkt, uint8_t len)
+{
+    PktHeader *hdr = (PktHeader *)pkt;
+    hdr->hop = 0;
+
+#if NRF_FHSS_ENABLED
+    // Every frame goes out on the next channel of the hop sequence
+    tuneHop(gHopIdx + 1);
+    hdr->hop = gHopIdx;
+#endif
+
+    // Load TX FIFO and keep CE high: radio stays in TX mode after the frame
+#if NRF_IRQ_PIN >= 0
+    gIrqPending = false;
+#endif
+    gRadio->startFastWrite(pkt, len, false);
+    gTxInFlight = true;
+    gTxStartUs = micros();
+}
+
+bool commQueueFrame(const CommFrame &tx)
+{
+    if (!gRadio || !gRadioOk || gTxInFlight)
+        return false;
+
+    // Convert application frame to on-air packet, limited by profile payload
+    const uint8_t maxPayload = commGetLinkProfileInfo(gProfile).payloadSize;
+    uint8_t count = tx.channelCount;
+    if (count == 0)
+        return false;
+    if (count > COMM_MAX_CHANNELS)
+        count = COMM_MAX_CHANNELS;
+    while (count > 1 && sizeof(PktHeader) + 1u + packedChannelBytes(count) > maxPayload)
+        count--;
+
+    uint8_t pkt[PKT_MAX_SIZE];
+    PktHeader *hdr = (PktHeader *)pkt;
+    hdr->verType = (uint8_t)((PKT_VERSION << 4) | PKT_TYPE_CHANNELS);
+    pkt[sizeof(PktHeader)] = count;
+    const uint8_t len = (uint8_t)(sizeof(PktHeader) + 1u +
+                                  packChannels(tx.ch, count, &pkt[sizeof(PktHeader) + 1]));
+
+    queuePacket(pkt, len);
+    return true;
+}
+
+bool commQueueFailsafe(const CommFailsafeConfig &cfg)
+{
+    if (!gRadio || !gRadioOk || gTxInFlight)
+        return false;
+
+    uint8_t total = cfg.channelCount;
+    if (total == 0)
+        return false;
+    if (total > COMM_MAX_CHANNELS)
+        total = COMM_MAX_CHANNELS;
+    if (gFsNextCh >= total)
+        gFsNextCh = 0;
+
+    // Largest chunk that fits the profile payload
+    const uint8_t maxPayload = commGetLinkProfileInfo(gProfile).payloadSize;
+    const uint8_t overhead = (uint8_t)(sizeof(PktHeader) + 2u);
+    uint8_t count = (uint8_t)(total - gFsNextCh);
+    while (count > 1 && overhead + packedModeBytes(count) + packedChannelBytes(count) > maxPayload)
+        count--;
+
+    uint8_t pkt[PKT_MAX_SIZE];
+    PktHeader *hdr = (PktHeader *)pkt;
+    hdr->verType = (uint8_t)((PKT_VERSION << 4) | PKT_TYPE_FAILSAFE);
+    uint8_t len = sizeof(PktHeader);
+    pkt[len++] = (uint8_t)((gFsNextCh << 4) | (count - 1u));
+    pkt[len++] = cfg.missedPeriods;
+
+    const uint8_t modeBytes = packedModeBytes(count);
+    memset(&pkt[len], 0, modeBytes);
+    for (uint8_t i = 0; i < count; ++i)
+        pkt[len + i / 4u] |= (uint8_t)(((uint8_t)cfg.mode[gFsNextCh + i] & 0x03u) << (2u * (i % 4u)));
+    len = (uint8_t)(len + modeBytes);
+    len = (uint8_t)(len + packChannels(&cfg.value[gFsNextCh], count, &pkt[len]));
+
+    gFsNextCh = (uint8_t)(gFsNextCh + count);
+    queuePacket(pkt, len);
+    return true;
+}
+
+bool commQueueBind(const uint8_t address[5], uint8_t modelId)
+{
+    if (!gRadio || !gRadioOk || gTxInFlight || !gBindMode)
+        return false;
+
+    uint8_t pkt[sizeof(PktHeader) + 6];
+    PktHeader *hdr = (PktHeader *)pkt;
+    hdr->verType = (uint8_t)((PKT_VERSION << 4) | PKT_TYPE_BIND);
+    memcpy(&pkt[sizeof(PktHeader)], address, 5);
+    pkt[sizeof(PktHeader) + 5] = modelId;
+
+    queuePacket(pkt, sizeof(pkt));
+    return true;
+}
+
+CommTxStatus commPollTx(CommTxInfo *info)
+{
+    if (!gRadio || !gRadioOk || !gTxInFlight)
+        return CommTxStatus::Idle;
 
-    // Read ACK payload (telemetry) if available
-    if (ok && rxAck && gRadio->isAckPayloadAvailable())
+    const bool timedOut = (micros() - gTxStartUs) > TX_TIMEOUT_US;
+
+#if NRF_IRQ_PIN >= 0
+    // No edge yet: skip the SPI status read entirely
+    if (!gIrqPending && !timedOut)
+        return CommTxStatus::Pending;
+    gIrqPending = false;
+#endif
+
+    // Reads and clears TX_DS / MAX_RT / RX_DR in one STATUS access
+    bool txOk = false;
+    bool txFail = false;
+    bool rxReady = false;
+    gRadio->whatHappened(txOk, txFail, rxReady);
+
+    if (!txOk && !txFail)
+    {
+        if (!timedOut)
+            return CommTxStatus::Pending;
+        txFail = true; // lost completion, recover the pipeline
+    }
+
+    gTxInFlight = false;
+
+    if (info)
+    {
+        // OBSERVE_TX.ARC is valid until the next payload is written
+        *info = CommTxInfo{};
+        info->retries = gRadio->getARC();
+        info->rttUs = micros() - gTxStartUs;
+    }
+
+    if (!txOk)
+    {
+        // MAX_RT keeps the payload in TX FIFO; drop it
+        gRadio->flush_tx();
+        return CommTxStatus::Failed;
+    }
+
+    if (info)
+        info->carrier = gRadio->testRPD(); // latched on ACK reception
+
+    // Read ACK payload (telemetry) if available, keep the latest
+    while (gRadio->available())
     {
-        AckPkt ap{};
-        gRadio->read(&ap, sizeof(ap));
-        rxAck->battPct = ap.battPct;
+        uint8_t ack[PKT_MAX_SIZE];
+        const uint8_t len = gRadio->getDynamicPayloadSize();
+        if (len == 0 || len > PKT_MAX_SIZE)
+            continue; // corrupt length: RF24 already flushed the RX FIFO
+        gRadio->read(ack, len);
+        if (!info || len < sizeof(AckHeader))
+            continue;
+
+        const AckHeader *hdr = (const AckHeader *)ack;
+        info->ackPayload = true;
+        info->rxFrames = hdr->rxFrames;
+        info->ackSeq = hdr->seq;
+        info->ackPrevWaitUs = (hdr->prevWait == 255) ? 0xFFFFU : (uint16_t)(hdr->prevWait * 100U);
+        info->telemetryLen = (uint8_t)(len - sizeof(AckHeader));
+        memcpy(info->telemetry, &ack[sizeof(AckHeader)], info->telemetryLen);
     }
 
-    return ok;
+    return CommTxStatus::Acked;
 }
 
 #elif defined(ROLE_RECEIVER)
 
-bool commSendFrame(const CommFrame &txTelemetry)
+bool commSendTelemetry()
 {
     if (!gRadio || !gRadioOk)
         return false;
 
-    // Prepare ACK payload (telemetry)
-    gAck.battPct = txTelemetry.battPct;
-    gAck.flags = 0;
+    RxIrqLock lock;
+    const uint32_t nowUs = micros();
+    const uint32_t periodUs = commGetLinkProfileInfo(gProfile).txPeriodUs;
+    const uint32_t intervalUs = (gRxIntervalUs > periodUs) ? gRxIntervalUs : periodUs;
+
+    if (gAckPending)
+    {
+        // Still waiting for a frame to carry it; drop it once it has gone stale
+        if (nowUs - gAckQueuedUs <= 2UL * intervalUs)
+            return true;
+        gRadio->flush_tx();
+        gAckPending = false;
+        gAckPrevWait = 255;
+    }
+
+    // While synced, write half a period before the next frame so the sample is fresh
+    if (gHopSynced && nowUs - gLastFrameUs < intervalUs - periodUs / 2UL)
+        return true;
+
+    // Prepare ACK payload: header + next round-robin slice of telemetry
+    uint8_t ack[sizeof(AckHeader) + COMM_ACK_TELEMETRY_MAX];
+    AckHeader *hdr = (AckHeader *)ack;
+    hdr->rxFrames = gRxFrames;
+    hdr->seq = ++gAckSeq;
+    hdr->prevWait = gAckPrevWait;
+    const uint8_t len = (uint8_t)(sizeof(AckHeader) +
+                                  telemetryPack(&ack[sizeof(AckHeader)], COMM_ACK_TELEMETRY_MAX));
 
     // Attach ACK payload to pipe 1 (control RX pipe)
-    return gRadio->writeAckPayload(1, &gAck, sizeof(gAck));
+    if (!gRadio->writeAckPayload(1, ack, len))
+        return false;
+
+    gAckPending = true;
+    gAckQueuedUs = nowUs;
+    return true;
+}
+
+void commRxTakeStats(CommRxStats &out)
+{
+    RxIrqLock lock;
+    out = gRxStats;
+    gRxStats = CommRxStats{0, 0};
+}
+
+/*
+ * Drains the RX FIFO: bookkeeping for every packet, control frames are
+ * published to the double buffer. Runs in the IRQ handler when
+ * NRF_IRQ_PIN is set, otherwise from commPollFrame().
+ */
+static void rxDrain(uint32_t nowUs)
+{
+    while (gRadio->available())
+    {
+        uint8_t pkt[PKT_MAX_SIZE];
+        const uint8_t len = gRadio->getDynamicPayloadSize();
+        if (len == 0 || len > PKT_MAX_SIZE)
+        {
+            // corrupt length: RF24 already flushed the RX FIFO
+            continue;
+        }
+        gRadio->read(pkt, len);
+
+        // Any packet on pipe 1 took the pending ACK payload with it
+        if (gAckPending)
+        {
+            const uint32_t waitX100 = (nowUs - gAckQueuedUs) / 100UL;
+            gAckPrevWait = (uint8_t)(waitX100 > 254UL ? 254UL : waitX100);
+            gAckPending = false;
+        }
+        // Frame spacing, rounded to whole periods (controller time slots)
+        if (gHopSynced)
+        {
+            const uint32_t periodUs = commGetLinkProfileInfo(gProfile).txPeriodUs;
+            const uint32_t slots = (nowUs - gLastFrameUs + periodUs / 2UL) / periodUs;
+            const uint32_t intervalUs = slots * periodUs;
+            // A shorter spacing is taken at once, a longer one (or a lost frame) must repeat
+            if (slots >= 1 && slots <= COMM_MAX_SLOTS)
+            {
+                if (intervalUs <= gRxIntervalUs || gRxIntervalUs == 0 || ++gRxIntervalVotes >= 4)
+                {
+                    gRxIntervalUs = intervalUs;
+                    gRxIntervalVotes = 0;
+                }
+            }
+        }
+        gLastFrameUs = nowUs;
+
+        const PktHeader *hdr = (const PktHeader *)pkt;
+        if (len < sizeof(PktHeader) + 1u || (hdr->verType >> 4) != PKT_VERSION)
+            continue;
+
+        if (gBindMode)
+        {
+            // Only bind offers are of interest, and they are not hop-synced
+            if ((hdr->verType & 0x0Fu) == PKT_TYPE_BIND && len >= sizeof(PktHeader) + 6u)
+            {
+                memcpy(gBindOffer, &pkt[sizeof(PktHeader)], 6);
+                gBindOfferValid = true;
+            }
+            continue;
+        }
+
+        hopOnFrame(hdr->hop, nowUs);
+
+        if ((hdr->verType & 0x0Fu) == PKT_TYPE_FAILSAFE)
+        {
+            memcpy(gFsPkt, pkt, len);
+            gFsPktLen = len;
+            continue;
+        }
+        if ((hdr->verType & 0x0Fu) != PKT_TYPE_CHANNELS)
+            continue;
+
+        const uint8_t count = pkt[sizeof(PktHeader)];
+        if (count == 0 || count > COMM_MAX_CHANNELS ||
+            len < sizeof(PktHeader) + 1u + packedChannelBytes(count))
+            continue;
+
+        RxFrameBuf &back = gRxBuf[gRxFront ^ 1u];
+        unpackChannels(&pkt[sizeof(PktHeader) + 1], count, back.frame.ch);
+        back.frame.channelCount = count;
+        back.arrivalUs = nowUs;
+        gRxFront = (uint8_t)(gRxFront ^ 1u);
+        gRxSeq = (uint8_t)(gRxSeq + 1u);
+
+        gRxFrames++;
+        gRxStats.frames++;
+        if (gRadio->testRPD())
+            gRxStats.carrier++;
+    }
+}
+
+#if NRF_IRQ_PIN >= 0
+static void rxServiceIrq(uint32_t nowUs)
+{
+    rxDrain(nowUs);
+
+    // RX_DR is cleared by read(); clear whatever is left so the line goes high
+    bool txOk, txFail, rxReady;
+    gRadio->whatHappened(txOk, txFail, rxReady);
+}
+
+static void onRadioIrq()
+{
+    // Timestamp first: arrival time is what the output code cares about
+    const uint32_t nowUs = micros();
+#if defined(__AVR__)
+    // SPI reads take ~100 us: run them with interrupts on and only this
+    // line masked, so output timer edges are not held up
+    EIMSK &= (uint8_t)~RX_IRQ_EIMSK_BIT;
+    sei();
+    rxServiceIrq(nowUs);
+    cli();
+    EIMSK |= RX_IRQ_EIMSK_BIT;
+#else
+    rxServiceIrq(nowUs);
+#endif
 }
+#endif
 
-bool commPollFrame(CommFrame &outFrame)
+bool commPollFrame(CommFrame &outFrame, uint32_t *arrivalUs)
 {
     if (!gRadio || !gRadioOk)
         return false;
 
-    bool got = false;
+    {
+        RxIrqLock lock;
+#if NRF_IRQ_PIN >= 0
+        // Missed edge (line still low): service it here
+        if (digitalRead(NRF_IRQ_PIN) == LOW)
+            rxServiceIrq(micros());
+#else
+        rxDrain(micros());
+#endif
+        hopService(micros());
+    }
 
-    // Drain RX FIFO, keep the latest frame
-    while (gRadio->available())
+    // Freshest frame; retry if the IRQ handler flipped buffers meanwhile
+    uint8_t seq;
+    do
+    {
+        seq = gRxSeq;
+        if (seq == gRxTakenSeq)
+            return false;
+        const RxFrameBuf &front = gRxBuf[gRxFront];
+        outFrame = front.frame;
+        if (arrivalUs)
+            *arrivalUs = front.arrivalUs;
+    } while (seq != gRxSeq);
+
+    gRxTakenSeq = seq;
+    return true;
+}
+
+bool commTakeFailsafeConfig(CommFailsafeConfig &cfg)
+{
+    uint8_t pkt[PKT_MAX_SIZE];
+    uint8_t len;
     {
-        TxPkt pkt{};
-        gRadio->read(&pkt, sizeof(pkt));
+        RxIrqLock lock;
+        len = gFsPktLen;
+        gFsPktLen = 0;
+        memcpy(pkt, gFsPkt, len);
+    }
+    if (len < sizeof(PktHeader) + 2u)
+        return false;
 
-        outFrame.lx = pkt.lx;
-        outFrame.ly = pkt.ly;
-        outFrame.rx = pkt.rx;
-        outFrame.ry = pkt.ry;
-        outFrame.joyButtons = pkt.joyButtons;
+    const uint8_t *p = &pkt[sizeof(PktHeader)];
+    const uint8_t first = (uint8_t)(p[0] >> 4);
+    const uint8_t count = (uint8_t)((p[0] & 0x0Fu) + 1u);
+    if (first + count > COMM_MAX_CHANNELS ||
+        len < sizeof(PktHeader) + 2u + packedModeBytes(count) + packedChannelBytes(count))
+        return false;
 
-        got = true;
+    cfg.missedPeriods = p[1];
+    const uint8_t *modes = &p[2];
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const uint8_t m = (uint8_t)((modes[i / 4u] >> (2u * (i % 4u))) & 0x03u);
+        cfg.mode[first + i] = (m < (uint8_t)CommFailsafeMode::Count) ? (CommFailsafeMode)m : CommFailsafeMode::Hold;
     }
+    unpackChannels(&modes[packedModeBytes(count)], count, &cfg.value[first]);
+    if (first + count > cfg.channelCount)
+        cfg.channelCount = (uint8_t)(first + count);
+    return true;
+}
+
+bool commTakeBind(uint8_t address[5], uint8_t &modelId)
+{
+    RxIrqLock lock;
+    if (!gBindOfferValid)
+        return false;
+    gBindOfferValid = false;
+    memcpy(address, gBindOffer, 5);
+    modelId = gBindOffer[5];
+    return true;
+}
 
-    return got;
+bool commRxHopSynced()
+{
+    return gHopSynced;
+}
+
+uint32_t commRxFrameIntervalUs()
+{
+    RxIrqLock lock;
+    const uint32_t periodUs = commGetLinkProfileInfo(gProfile).txPeriodUs;
+    return (gRxIntervalUs > periodUs) ? gRxIntervalUs : periodUs;
 }
 
 #endif
@@ -0,0 +1,205 @@
+#include <common/input_filter.h>
+#include <math.h>
+
+#define Q28_ONE 268435456.0f
+#define EURO_SPEED_LIMIT (1L << 29) // keeps the speed update inside int32
+
+// Index = strength - 1
+static const float kBiquadCutoffHz[INPUT_FILTER_STRENGTH_MAX] = {40.0f, 25.0f, 15.0f, 10.0f, 6.0f};
+static const float kEuroMinCutoffHz[INPUT_FILTER_STRENGTH_MAX] = {8.0f, 4.0f, 2.0f, 1.0f, 0.5f};
+
+static int32_t toQ28(float v)
+{
+    return (int32_t)lroundf(v * Q28_ONE);
+}
+
+static uint16_t fromQ4(int32_t v)
+{
+    v = (v + 8) >> 4;
+    if (v < 0)
+        return 0;
+    if (v > 0xFFFF)
+        return 0xFFFF;
+    return (uint16_t)v;
+}
+
+void InputFilter::configure(const InputFilterConfig &c, uint32_t sampleRateHz)
+{
+    cfg = c;
+    if ((uint8_t)cfg.type >= (uint8_t)InputFilterType::Count)
+        cfg.type = InputFilterType::Off;
+    if (cfg.strength < 1)
+        cfg.strength = 1;
+    if (cfg.strength > INPUT_FILTER_STRENGTH_MAX)
+        cfg.strength = INPUT_FILTER_STRENGTH_MAX;
+
+    rateHz = sampleRateHz ? sampleRateHz : 1;
+    const float fs = (float)rateHz;
+    float delaySamples = 0.0f;
+
+    switch (cfg.type)
+    {
+    case InputFilterType::Ema:
+    {
+        const float a = 1.0f / (float)(1u << cfg.strength);
+        delaySamples = (1.0f - a) / a;
+        break;
+    }
+
+    case InputFilterType::Median:
+        taps = (uint8_t)(2 * cfg.strength + 1);
+        delaySamples = (float)cfg.strength;
+        break;
+
+    case InputFilterType::Biquad:
+    {
+        float fc = kBiquadCutoffHz[cfg.strength - 1];
+        if (fc > 0.4f * fs)
+            fc = 0.4f * fs;
+
+        // RBJ low-pass, Q = 1/sqrt(2)
+        const float w0 = 2.0f * (float)M_PI * fc / fs;
+        const float cosW = cosf(w0);
+        const float alpha = sinf(w0) * 0.70710678f;
+        const float a0 = 1.0f + alpha;
+        const float fb0 = (1.0f - cosW) * 0.5f / a0;
+        const float fb1 = (1.0f - cosW) / a0;
+        const float fa1 = -2.0f * cosW / a0;
+        const float fa2 = (1.0f - alpha) / a0;
+        b0 = toQ28(fb0);
+        b1 = toQ28(fb1);
+        b2 = b0;
+        a1 = toQ28(fa1);
+        a2 = toQ28(fa2);
+
+        // Group delay at DC of B(z)/A(z): sum(k*b_k)/sum(b_k) - sum(k*a_k)/sum(a_k)
+        delaySamples = (fb1 + 2.0f * fb0) / (2.0f * fb0 + fb1) - (fa1 + 2.0f * fa2) / (1.0f + fa1 + fa2);
+        break;
+    }
+
+    case InputFilterType::OneEuro:
+    {
+        omegaQ16 = (uint32_t)lroundf(2.0f * (float)M_PI / fs * 65536.0f);
+        minCutQ8 = (uint32_t)lroundf(kEuroMinCutoffHz[cfg.strength - 1] * 256.0f);
+        dAlphaQ16 = euroAlphaQ16((uint32_t)lroundf(INPUT_FILTER_EURO_DCUTOFF_HZ * 256.0f));
+        const float a = (float)euroAlphaQ16(minCutQ8) / 65536.0f;
+        delaySamples = (a > 0.0f) ? (1.0f - a) / a : 0.0f;
+        break;
+    }
+
+    case InputFilterType::Off:
+    default:
+        break;
+    }
+
+    delayUs = (uint32_t)(delaySamples * 1000000.0f / fs + 0.5f);
+    reset();
+}
+
+void InputFilter::reset()
+{
+    primed = false;
+}
+
+// One pole smoothing factor for a cutoff: alpha = w / (w + 1), w = 2*pi*fc/fs
+uint32_t InputFilter::euroAlphaQ16(uint32_t cutQ8) const
+{
+    const uint64_t w = ((uint64_t)cutQ8 * omegaQ16) >> 8;
+    return (uint32_t)((w << 16) / (w + 65536u));
+}
+
+uint16_t InputFilter::update(uint16_t x)
+{
+    if (cfg.type == InputFilterType::Off)
+        return x;
+
+    if (!primed)
+    {
+        // Start from steady state at the first sample
+        const int32_t xq = (int32_t)x << 4;
+        ema = (int32_t)x << 8;
+        ringPos = 0;
+        ringCount = 0;
+        x1 = x2 = y1 = y2 = xq;
+        xHat = xq;
+        dxHat = 0;
+        primed = true;
+        if (cfg.type != InputFilterType::Median)
+            return x;
+    }
+
+    switch (cfg.type)
+    {
+    case InputFilterType::Ema:
+        ema += (((int32_t)x << 8) - ema) >> cfg.strength;
+        return (uint16_t)((ema + 128) >> 8);
+    case InputFilterType::Median:
+        return updateMedian(x);
+    case InputFilterType::Biquad:
+        return updateBiquad(x);
+    case InputFilterType::OneEuro:
+        return updateOneEuro(x);
+    default:
+        return x;
+    }
+}
+
+uint16_t InputFilter::updateMedian(uint16_t x)
+{
+    ring[ringPos] = x;
+    ringPos = (uint8_t)((ringPos + 1) % taps);
+    if (ringCount < taps)
+        ++ringCount;
+
+    // Insertion sort of a copy; at most INPUT_FILTER_MEDIAN_MAX values
+    uint16_t sorted[INPUT_FILTER_MEDIAN_MAX];
+    for (uint8_t i = 0; i < ringCount; ++i)
+    {
+        const uint16_t v = ring[i];
+        uint8_t j = i;
+        while (j > 0 && sorted[j - 1] > v)
+        {
+            sorted[j] = sorted[j - 1];
+            --j;
+        }
+        sorted[j] = v;
+    }
+    return sorted[ringCount / 2];
+}
+
+uint16_t InputFilter::updateBiquad(uint16_t x)
+{
+    const int32_t x0 = (int32_t)x << 4;
+    const int64_t acc = (int64_t)b0 * x0 + (int64_t)b1 * x1 + (int64_t)b2 * x2 -
+                        (int64_t)a1 * y1 - (int64_t)a2 * y2;
+    const int32_t y0 = (int32_t)((acc + (1L << 27)) >> 28);
+
+    x2 = x1;
+    x1 = x0;
+    y2 = y1;
+    y1 = y0;
+    return fromQ4(y0);
+}
+
+uint16_t InputFilter::updateOneEuro(uint16_t x)
+{
+    const int32_t xq = (int32_t)x << 4;
+
+    // Speed from the previous estimate, smoothed at the fixed speed cutoff
+    int64_t dx = (int64_t)(xq - xHat) * (int64_t)rateHz;
+    if (dx > EURO_SPEED_LIMIT)
+        dx = EURO_SPEED_LIMIT;
+    if (dx < -EURO_SPEED_LIMIT)
+        dx = -EURO_SPEED_LIMIT;
+    dxHat += (int32_t)(((dx - dxHat) * (int64_t)dAlphaQ16) >> 16);
+
+    // Cutoff rises with speed; above Nyquist alpha is ~1 anyway
+    const uint32_t speed = (uint32_t)((dxHat < 0) ? -dxHat : dxHat);
+    uint64_t cutQ8 = minCutQ8 + (((uint64_t)INPUT_FILTER_EURO_BETA_Q16 * speed) >> 12);
+    if (cutQ8 > ((uint64_t)rateHz << 8))
+        cutQ8 = (uint64_t)rateHz << 8;
+
+    const uint32_t alpha = euroAlphaQ16((uint32_t)cutQ8);
+    xHat += (int32_t)(((int64_t)(xq - xHat) * alpha) >> 16);
+    return fromQ4(xHat);
+}
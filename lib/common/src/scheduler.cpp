@@ -0,0 +1,155 @@
+#include <common/scheduler.h>
+#include <Arduino.h>
+
+// st.name and st.periodUs are the task's own name and period
+struct SchedTask
+{
+    SchedFn fn;
+    uint32_t dueUs;
+    uint8_t priority;
+    SchedStats st;
+};
+
+static SchedTask tasks[SCHED_MAX_TASKS];
+static uint8_t taskCount = 0;
+
+static uint16_t sat16(uint32_t v)
+{
+    return (v > 0xFFFFUL) ? 0xFFFFU : (uint16_t)v;
+}
+
+static void ema8(uint16_t &avg, uint16_t v)
+{
+    avg = (uint16_t)((int32_t)avg + (((int32_t)v - (int32_t)avg) >> 3));
+}
+
+int8_t schedAdd(const char *name, SchedFn fn, uint32_t periodUs, uint32_t phaseUs, uint8_t priority)
+{
+    if (taskCount >= SCHED_MAX_TASKS || fn == nullptr)
+        return -1;
+
+    SchedTask &t = tasks[taskCount];
+    t.fn = fn;
+    t.dueUs = micros() + phaseUs;
+    t.priority = priority;
+    t.st = SchedStats{};
+    t.st.name = name;
+    t.st.periodUs = periodUs;
+    return (int8_t)taskCount++;
+}
+
+void schedSetPeriod(int8_t id, uint32_t periodUs)
+{
+    if (id < 0 || id >= (int8_t)taskCount)
+        return;
+    tasks[id].st.periodUs = periodUs;
+}
+
+// Highest priority due task not run in this pass; ties: earliest release
+static int8_t pickDue(uint32_t now, uint32_t ranMask)
+{
+    int8_t best = -1;
+    for (uint8_t i = 0; i < taskCount; ++i)
+    {
+        if (ranMask & (1UL << i))
+            continue;
+        const SchedTask &t = tasks[i];
+        if ((int32_t)(now - t.dueUs) < 0)
+            continue;
+        if (best < 0 || t.priority > tasks[best].priority ||
+            (t.priority == tasks[best].priority && (int32_t)(t.dueUs - tasks[best].dueUs) < 0))
+            best = (int8_t)i;
+    }
+    return best;
+}
+
+static void runTask(SchedTask &t, uint32_t start)
+{
+    const uint32_t lateUs = start - t.dueUs;
+    uint32_t deadline = t.dueUs + t.st.periodUs;
+
+    // Drop the releases that passed while the task was waiting
+    if (t.st.periodUs != 0 && lateUs >= t.st.periodUs)
+    {
+        const uint32_t drop = lateUs / t.st.periodUs;
+        t.st.skipped = sat16((uint32_t)t.st.skipped + drop);
+        t.dueUs += drop * t.st.periodUs;
+        deadline = t.dueUs + t.st.periodUs;
+    }
+
+    t.fn();
+    const uint32_t end = micros();
+
+    const uint16_t exec = sat16(end - start);
+    const uint16_t jitter = sat16(lateUs);
+    if (t.st.runs == 0)
+    {
+        t.st.execAvgUs = exec;
+        t.st.jitterAvgUs = jitter;
+    }
+    else
+    {
+        ema8(t.st.execAvgUs, exec);
+        ema8(t.st.jitterAvgUs, jitter);
+    }
+    if (exec > t.st.execMaxUs)
+        t.st.execMaxUs = exec;
+    if (jitter > t.st.jitterMaxUs)
+        t.st.jitterMaxUs = jitter;
+    if (t.st.periodUs != 0 && (int32_t)(end - deadline) > 0 && t.st.missed != 0xFFFFU)
+        t.st.missed++;
+    t.st.runs++;
+
+    t.dueUs = (t.st.periodUs != 0) ? t.dueUs + t.st.periodUs : end;
+}
+
+uint32_t schedRun()
+{
+    uint32_t ranMask = 0;
+    for (;;)
+    {
+        const uint32_t now = micros();
+        const int8_t i = pickDue(now, ranMask);
+        if (i < 0)
+            break;
+        ranMask |= 1UL << i;
+        runTask(tasks[i], now);
+    }
+
+    const uint32_t now = micros();
+    uint32_t wait = 0xFFFFFFFFUL;
+    for (uint8_t i = 0; i < taskCount; ++i)
+    {
+        const int32_t left = (int32_t)(tasks[i].dueUs - now);
+        if (left <= 0)
+            return 0;
+        if ((uint32_t)left < wait)
+            wait = (uint32_t)left;
+    }
+    return wait;
+}
+
+uint8_t schedCount()
+{
+    return taskCount;
+}
+
+bool schedGetStats(int8_t id, SchedStats &out)
+{
+    if (id < 0 || id >= (int8_t)taskCount)
+        return false;
+    out = tasks[id].st;
+    return true;
+}
+
+void schedResetStats()
+{
+    for (uint8_t i = 0; i < taskCount; ++i)
+    {
+        SchedStats &st = tasks[i].st;
+        const SchedStats keep = st;
+        st = SchedStats{};
+        st.name = keep.name;
+        st.periodUs = keep.periodUs;
+    }
+}
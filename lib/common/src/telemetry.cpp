@@ -0,0 +1,104 @@
+#include <common/telemetry.h>
+
+struct TelemetrySlot
+{
+    uint8_t id;  // TelemetryId, 0 = free
+    uint8_t len; // 1..4
+    uint32_t value;
+};
+
+static TelemetrySlot gSlots[TELEMETRY_MAX_ITEMS] = {};
+static uint8_t gNextSlot = 0;
+
+static inline uint8_t makeTag(uint8_t id, uint8_t len)
+{
+    return (uint8_t)((id << 2) | (uint8_t)(len - 1u));
+}
+
+bool telemetrySet(TelemetryId id, uint32_t value, uint8_t len)
+{
+    const uint8_t raw = (uint8_t)id;
+    if (raw == 0 || raw > (uint8_t)TelemetryId::Max || len < 1 || len > 4)
+        return false;
+
+    TelemetrySlot *free = nullptr;
+    for (uint8_t i = 0; i < TELEMETRY_MAX_ITEMS; ++i)
+    {
+        if (gSlots[i].id == raw)
+        {
+            gSlots[i].len = len;
+            gSlots[i].value = value;
+            return true;
+        }
+        if (!free && gSlots[i].id == 0)
+            free = &gSlots[i];
+    }
+
+    if (!free)
+        return false;
+
+    free->id = raw;
+    free->len = len;
+    free->value = value;
+    return true;
+}
+
+uint8_t telemetryPack(uint8_t *dst, uint8_t capacity)
+{
+    if (!dst)
+        return 0;
+
+    uint8_t used = 0;
+
+    // One pass over the table at most, beginning where the last pack stopped
+    for (uint8_t n = 0; n < TELEMETRY_MAX_ITEMS; ++n)
+    {
+        const uint8_t i = (uint8_t)((gNextSlot + n) % TELEMETRY_MAX_ITEMS);
+        const TelemetrySlot &s = gSlots[i];
+        if (s.id == 0)
+            continue;
+
+        if ((uint8_t)(used + 1u + s.len) > capacity)
+        {
+            gNextSlot = i; // does not fit: goes first next time
+            return used;
+        }
+
+        dst[used++] = makeTag(s.id, s.len);
+        uint32_t v = s.value;
+        for (uint8_t b = 0; b < s.len; ++b)
+        {
+            dst[used++] = (uint8_t)v;
+            v >>= 8;
+        }
+    }
+
+    return used;
+}
+
+uint8_t telemetryDecode(const uint8_t *src, uint8_t len, TelemetryItemFn fn, void *ctx)
+{
+    if (!src || !fn)
+        return 0;
+
+    uint8_t items = 0;
+    uint8_t pos = 0;
+    while (pos < len)
+    {
+        const uint8_t tag = src[pos++];
+        const uint8_t id = (uint8_t)(tag >> 2);
+        const uint8_t n = (uint8_t)((tag & 0x03u) + 1u);
+        if (id == 0 || (uint8_t)(pos + n) > len)
+            break;
+
+        uint32_t value = 0;
+        for (uint8_t b = 0; b < n; ++b)
+            value |= (uint32_t)src[pos + b] << (8u * b);
+        pos = (uint8_t)(pos + n);
+
+        fn((TelemetryId)id, value, ctx);
+        items++;
+    }
+
+    return items;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <stdint.h>
+
+/*
+ * ===== Bind record (receiver EEPROM) =====
+ *
+ * Pair address and model id handed out by the controller in bind mode.
+ * Stored with magic + checksum at BIND_STORE_EEPROM_ADDR.
+ */
+#ifndef BIND_STORE_EEPROM_ADDR
+#define BIND_STORE_EEPROM_ADDR 0
+#endif
+
+struct BindRecord
+{
+    uint8_t address[5];
+    uint8_t modelId;
+};
+
+// Returns false if EEPROM holds no valid record (never bound).
+bool bindStoreLoad(BindRecord &out);
+void bindStoreSave(const BindRecord &rec);
@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include "common/comm.h"
+
+/*
+ * ===== Receiver failsafe =====
+ *
+ * Link loss is declared when no control frame arrived for
+ * missedPeriods frame periods of the active link profile (plus half a
+ * period of tolerance for jitter). While lost, each channel follows its
+ * CommFailsafeMode: hold the last value, go to the preset or cut.
+ *
+ * Time is passed in by the caller (micros()), so the module has no
+ * hardware dependency.
+ */
+
+#define FAILSAFE_MISSED_PERIODS_MIN 1
+
+struct FailsafeStats
+{
+    bool active;           // failsafe outputs in use
+    uint16_t activations;  // link losses since init
+    uint32_t thresholdUs;  // current detection threshold
+    uint32_t lastDetectUs; // last frame -> loss declared, for the latest activation
+};
+
+// Starts in failsafe with all channels on Hold; until the first frame
+// arrives there is nothing to hold, so Hold channels output COMM_CH_CUT.
+void failsafeInit(uint32_t periodUs, uint8_t missedPeriods);
+
+// Frame period of the active link profile; call on every profile change.
+void failsafeSetPeriod(uint32_t periodUs);
+
+void failsafeSetConfig(const CommFailsafeConfig &cfg);
+const CommFailsafeConfig &failsafeGetConfig();
+
+// Feed every received control frame.
+void failsafeOnFrame(const CommFrame &rx, uint32_t nowUs);
+
+/*
+ * Call every loop. out receives the channels to drive the outputs with:
+ * the last frame while the link is up, the failsafe values otherwise.
+ * Returns true while failsafe is active.
+ */
+bool failsafeUpdate(uint32_t nowUs, CommFrame &out);
+
+FailsafeStats failsafeGetStats();
@@ -0,0 +1,47 @@
+#pragma once
+#include <stdint.h>
+#include "common/comm.h"
+#include "receiver/pulse_schedule.h"
+
+/*
+ * ===== Output engine (AVR) =====
+ *
+ * Drives servos / ESCs from the failsafe-applied frame:
+ * - PWM: OUTPUT_PWM_RATE_MIN..MAX_HZ, all outputs start together
+ * - PPM: OUTPUT_MAX_CHANNELS channel train on pin[0]
+ * - SBUS: 100000 baud 8E2 on the hardware UART. SBUS is inverted:
+ *   the ATmega328 UART cannot invert, so an external inverter is needed
+ *   and Serial is not available for logs.
+ *
+ * PWM and PPM edges come from Timer1 compare interrupts: the ISR wakes
+ * a few microseconds early and spins on TCNT1 to the exact tick, so
+ * another interrupt running at the time (millis, nRF24 IRQ) does not
+ * move the edge. Timer1 is owned by the engine (no Servo library, no
+ * analogWrite on D9/D10).
+ *
+ * Schedules are built from pulse_schedule.h in outputWrite() and
+ * double-buffered: the ISR picks up the newest one at a frame boundary.
+ */
+
+enum class OutputMode : uint8_t
+{
+    Pwm = 0,
+    Ppm,
+    Sbus,
+    Count
+};
+
+struct OutputConfig
+{
+    OutputMode mode;
+    uint16_t pwmRateHz; // PWM only
+    uint8_t count;      // outputs in use, <= OUTPUT_MAX_CHANNELS
+    uint8_t channel[OUTPUT_MAX_CHANNELS]; // output i follows frame channel channel[i]
+    uint8_t pin[OUTPUT_MAX_CHANNELS];     // PWM: pin per output, PPM: pin[0], SBUS: unused
+};
+
+// Returns false for an invalid config (outputs stay off).
+bool outputInit(const OutputConfig &cfg);
+
+// Call every loop with the frame to drive the outputs with.
+void outputWrite(const CommFrame &frame);
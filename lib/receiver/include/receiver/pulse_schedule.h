@@ -0,0 +1,75 @@
+#pragma once
+#include <stdint.h>
+#include "common/comm.h"
+
+/*
+ * ===== Pulse schedules =====
+ *
+ * Pure timing math behind the output engine (output.h): channel values
+ * become a list of pin edges relative to the start of an output frame.
+ * No hardware access, so it builds and runs on the host as well.
+ *
+ * - PWM: every active output goes high at t = 0 and low after its
+ *   pulse width; outputs with equal widths share one edge.
+ * - PPM: one line, idle high; every channel starts with a
+ *   OUTPUT_PPM_SYNC_US low pulse, channel width is rising to rising
+ *   edge, and the frame ends with a sync gap of at least
+ *   OUTPUT_PPM_GAP_MIN_US.
+ * - SBUS: 25-byte frame with 16 11-bit channels and a flags byte.
+ *
+ * COMM_CH_CUT channels produce no pulse in PWM. PPM and SBUS have no
+ * per-channel "off": a cut channel goes out at OUTPUT_PULSE_MIN_US, and
+ * when every channel is cut the PPM train stops and SBUS sets its
+ * failsafe flag.
+ */
+
+#define OUTPUT_MAX_CHANNELS 8
+
+#define OUTPUT_PULSE_MIN_US 1000
+#define OUTPUT_PULSE_CENTER_US 1500
+#define OUTPUT_PULSE_MAX_US 2000
+
+#define OUTPUT_PWM_RATE_MIN_HZ 50
+#define OUTPUT_PWM_RATE_MAX_HZ 400
+#define OUTPUT_PWM_GAP_MIN_US 400 // low time after the longest pulse at the highest rate
+
+#define OUTPUT_PPM_FRAME_US 22500
+#define OUTPUT_PPM_SYNC_US 300
+#define OUTPUT_PPM_GAP_MIN_US 4000
+
+#define OUTPUT_SBUS_FRAME_SIZE 25
+#define OUTPUT_SBUS_CHANNELS 16
+#define OUTPUT_SBUS_FLAG_FRAME_LOST 0x04
+#define OUTPUT_SBUS_FLAG_FAILSAFE 0x08
+
+// One pin edge: outputs in mask (bit per output) go to level at atUs
+struct PulseEdge
+{
+    uint16_t atUs;
+    uint8_t mask;
+    uint8_t level;
+};
+
+struct PulseSchedule
+{
+    uint16_t frameUs;  // next frame starts here
+    uint8_t edgeCount; // 0: outputs stay low (PWM) / idle (PPM)
+    PulseEdge edge[2 * OUTPUT_MAX_CHANNELS + 2];
+};
+
+// Pulse width of a channel value (COMM_CH_CUT -> 0: no pulse).
+uint16_t pulseChannelToUs(uint16_t ch);
+
+// Output frame length for a PWM rate (clamped to OUTPUT_PWM_RATE_MIN/MAX_HZ).
+uint16_t pulsePwmFrameUs(uint16_t rateHz);
+
+/*
+ * widthUs[i] is the pulse of output i (0 = none), count <= OUTPUT_MAX_CHANNELS.
+ * Edges come out sorted by time. Returns false for invalid input, which
+ * leaves out empty.
+ */
+bool pulseBuildPwm(const uint16_t *widthUs, uint8_t count, uint16_t frameUs, PulseSchedule &out);
+bool pulseBuildPpm(const uint16_t *widthUs, uint8_t count, PulseSchedule &out);
+
+// Packs up to OUTPUT_SBUS_CHANNELS pulse widths (0 = cut) into an SBUS frame.
+void pulseBuildSbus(const uint16_t *widthUs, uint8_t count, uint8_t out[OUTPUT_SBUS_FRAME_SIZE]);
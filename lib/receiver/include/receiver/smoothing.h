@@ -0,0 +1,60 @@
+#pragma once
+#include <stdint.h>
+#include "common/comm.h"
+
+/*
+ * ===== Frame smoothing =====
+ *
+ * Optional stage between received frames and the outputs: the outputs
+ * run faster than the link (PWM up to 400 Hz vs. 50 Hz link), so
+ * channels are rendered between frames instead of stepping.
+ *
+ * Per channel:
+ * - Off: latest received value (switches).
+ * - Linear: straight line from the previous to the latest frame over one
+ *   frame interval. Adds one interval of latency, never overshoots.
+ * - Damped: critically damped (two equal poles) follower of the latest
+ *   value; strength is its time constant in percent of the frame interval.
+ *
+ * Missing frames: the last slope is extended for up to
+ * SmoothConfig::extrapFrames intervals, then the value holds until a frame
+ * arrives or failsafe takes over (call smoothReset() while it is active).
+ *
+ * Time is passed in by the caller (micros()), so the module has no
+ * hardware dependency.
+ */
+
+enum class SmoothMode : uint8_t
+{
+    Off = 0,
+    Linear,
+    Damped,
+    Count
+};
+
+#define SMOOTH_EXTRAP_FRAMES_MAX 2
+
+struct SmoothConfig
+{
+    uint8_t extrapFrames; // 0..SMOOTH_EXTRAP_FRAMES_MAX
+    SmoothMode mode[COMM_MAX_CHANNELS];
+    uint8_t strength[COMM_MAX_CHANNELS]; // Damped: time constant, % of the frame interval
+};
+
+// All channels Off; intervalUs is the expected time between own frames.
+void smoothInit(uint32_t intervalUs);
+
+// Frame interval changed (link profile, controller time slots); cheap when unchanged.
+void smoothSetInterval(uint32_t intervalUs);
+
+void smoothSetConfig(const SmoothConfig &cfg);
+const SmoothConfig &smoothGetConfig();
+
+// Feed every received control frame with its arrival time.
+void smoothOnFrame(const CommFrame &rx, uint32_t arrivalUs);
+
+// Forget the history: the next frame is taken as is (after failsafe).
+void smoothReset();
+
+// Call every loop: out receives the channels for the outputs.
+void smoothUpdate(uint32_t nowUs, CommFrame &out);
@@ -0,0 +1,40 @@
+#include <receiver/bind_store.h>
+#include <EEPROM.h>
+
+struct StoredBind
+{
+    uint16_t magic;
+    BindRecord rec;
+    uint16_t crc;
+};
+
+static const uint16_t BIND_MAGIC = 0xB1D5;
+
+static uint16_t crcBind(const StoredBind &d)
+{
+    const uint8_t *p = (const uint8_t *)&d.rec;
+    uint16_t crc = (uint16_t)(d.magic ^ 0x7E81);
+    for (uint8_t i = 0; i < sizeof(d.rec); ++i)
+        crc = (uint16_t)(((crc << 1) | (crc >> 15)) ^ p[i]);
+    return crc;
+}
+
+bool bindStoreLoad(BindRecord &out)
+{
+    StoredBind d{};
+    EEPROM.get(BIND_STORE_EEPROM_ADDR, d);
+    if (d.magic != BIND_MAGIC || d.crc != crcBind(d))
+        return false;
+
+    out = d.rec;
+    return true;
+}
+
+void bindStoreSave(const BindRecord &rec)
+{
+    StoredBind d{};
+    d.magic = BIND_MAGIC;
+    d.rec = rec;
+    d.crc = crcBind(d);
+    EEPROM.put(BIND_STORE_EEPROM_ADDR, d); // AVR: only changed bytes are written
+}
@@ -0,0 +1,114 @@
+#include <receiver/failsafe.h>
+
+static CommFailsafeConfig gCfg{};
+static CommFrame gLastGood{};
+static uint32_t gPeriodUs = 20000UL;
+static uint32_t gThresholdUs = 0;
+static uint32_t gLastFrameUs = 0;
+static bool gHaveFrame = false;
+static bool gActive = true;
+static uint16_t gActivations = 0;
+static uint32_t gLastDetectUs = 0;
+
+static void updateThreshold()
+{
+    uint8_t missed = gCfg.missedPeriods;
+    if (missed < FAILSAFE_MISSED_PERIODS_MIN)
+        missed = FAILSAFE_MISSED_PERIODS_MIN;
+    gThresholdUs = gPeriodUs * (uint32_t)missed + gPeriodUs / 2UL;
+}
+
+void failsafeInit(uint32_t periodUs, uint8_t missedPeriods)
+{
+    gCfg = CommFailsafeConfig{};
+    gCfg.missedPeriods = missedPeriods;
+    gCfg.channelCount = COMM_MAX_CHANNELS;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+    {
+        gCfg.mode[i] = CommFailsafeMode::Hold;
+        gCfg.value[i] = COMM_CH_CENTER;
+        gLastGood.ch[i] = COMM_CH_CENTER;
+    }
+    gLastGood.channelCount = COMM_CH_DEFAULT_COUNT;
+
+    gPeriodUs = periodUs;
+    gHaveFrame = false;
+    gActive = true;
+    gActivations = 0;
+    gLastDetectUs = 0;
+    updateThreshold();
+}
+
+void failsafeSetPeriod(uint32_t periodUs)
+{
+    gPeriodUs = periodUs;
+    updateThreshold();
+}
+
+void failsafeSetConfig(const CommFailsafeConfig &cfg)
+{
+    gCfg = cfg;
+    updateThreshold();
+}
+
+const CommFailsafeConfig &failsafeGetConfig()
+{
+    return gCfg;
+}
+
+void failsafeOnFrame(const CommFrame &rx, uint32_t nowUs)
+{
+    // Keep channels the frame does not carry (payload-limited profiles)
+    for (uint8_t i = 0; i < rx.channelCount && i < COMM_MAX_CHANNELS; ++i)
+        gLastGood.ch[i] = rx.ch[i];
+    if (rx.channelCount > gLastGood.channelCount)
+        gLastGood.channelCount = rx.channelCount;
+
+    gLastFrameUs = nowUs;
+    gHaveFrame = true;
+    gActive = false;
+}
+
+bool failsafeUpdate(uint32_t nowUs, CommFrame &out)
+{
+    if (!gActive && nowUs - gLastFrameUs > gThresholdUs)
+    {
+        gActive = true;
+        gActivations++;
+        gLastDetectUs = nowUs - gLastFrameUs;
+    }
+
+    out = gLastGood;
+    if (!gActive)
+        return false;
+
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+    {
+        switch (gCfg.mode[i])
+        {
+        case CommFailsafeMode::Preset:
+            out.ch[i] = gCfg.value[i];
+            break;
+        case CommFailsafeMode::Cut:
+            out.ch[i] = COMM_CH_CUT;
+            break;
+        case CommFailsafeMode::Hold:
+        default:
+            // Nothing to hold before the first frame: stay off
+            if (!gHaveFrame)
+                out.ch[i] = COMM_CH_CUT;
+            break;
+        }
+    }
+    return true;
+}
+
+FailsafeStats failsafeGetStats()
+{
+    FailsafeStats s{};
+    s.active = gActive;
+    s.activations = gActivations;
+    s.thresholdUs = gThresholdUs;
+    s.lastDetectUs = gLastDetectUs;
+    return s;
+}
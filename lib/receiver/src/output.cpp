@@ -0,0 +1,259 @@
+#include <Arduino.h>
+#include <receiver/output.h>
+
+#if defined(__AVR__)
+
+// Timer1 at clk/8: 0.5 us per tick on a 16 MHz Nano
+static const uint8_t TICKS_PER_US = (uint8_t)(F_CPU / 8000000UL);
+static const uint16_t WAKE_LEAD_TICKS = 12 * TICKS_PER_US; // covers the millis ISR + our entry
+static const uint16_t REARM_MIN_TICKS = 20 * TICKS_PER_US; // closer than this: spin instead
+static const uint16_t LONG_WAIT_TICKS = 0x4000;            // compare never armed further ahead
+
+static const uint32_t SBUS_PERIOD_US = 14000UL;
+static const uint8_t MAX_PORTS = 3;
+
+// Edge as port writes: PORTx = (PORTx & andMask) | orMask
+struct HwEdge
+{
+    uint16_t atTicks;
+    uint8_t andMask[MAX_PORTS];
+    uint8_t orMask[MAX_PORTS];
+};
+
+struct HwSchedule
+{
+    uint16_t frameTicks;
+    uint8_t edgeCount;
+    HwEdge edge[sizeof(PulseSchedule::edge) / sizeof(PulseEdge)];
+};
+
+static OutputConfig gCfg{};
+static bool gRunning = false;
+
+// Output bit -> port register index + pin bit
+static volatile uint8_t *gPortReg[MAX_PORTS];
+static uint8_t gPortCount = 0;
+static uint8_t gOutPort[OUTPUT_MAX_CHANNELS];
+static uint8_t gOutBit[OUTPUT_MAX_CHANNELS];
+
+// Double buffer: main loop fills gSched[gActive ^ 1] and sets gPending
+static HwSchedule gSched[2];
+static volatile uint8_t gActive = 0;
+static volatile bool gPending = false;
+
+// ISR state
+static uint16_t gFrameStart = 0;
+static uint8_t gEdge = 0;
+static uint16_t gNextAt = 0; // tick of the next edge or frame boundary
+static uint16_t gWakeAt = 0; // compare value currently armed
+
+static uint32_t lastSbusUs = 0;
+
+static bool mapPins()
+{
+    gPortCount = 0;
+    const uint8_t pins = (gCfg.mode == OutputMode::Ppm) ? 1 : gCfg.count;
+    for (uint8_t i = 0; i < pins; ++i)
+    {
+        const uint8_t port = digitalPinToPort(gCfg.pin[i]);
+        if (port == NOT_A_PORT)
+            return false;
+
+        volatile uint8_t *reg = portOutputRegister(port);
+        uint8_t idx = 0;
+        while (idx < gPortCount && gPortReg[idx] != reg)
+            idx++;
+        if (idx == gPortCount)
+        {
+            if (gPortCount >= MAX_PORTS)
+                return false;
+            gPortReg[gPortCount++] = reg;
+        }
+        gOutPort[i] = idx;
+        gOutBit[i] = digitalPinToBitMask(gCfg.pin[i]);
+
+        pinMode(gCfg.pin[i], OUTPUT);
+        digitalWrite(gCfg.pin[i], gCfg.mode == OutputMode::Ppm ? HIGH : LOW); // PPM idles high
+    }
+    return true;
+}
+
+static void toHw(const PulseSchedule &src, HwSchedule &dst)
+{
+    dst.frameTicks = (uint16_t)(src.frameUs * TICKS_PER_US);
+    dst.edgeCount = src.edgeCount;
+    for (uint8_t e = 0; e < src.edgeCount; ++e)
+    {
+        HwEdge &h = dst.edge[e];
+        h.atTicks = (uint16_t)(src.edge[e].atUs * TICKS_PER_US);
+        for (uint8_t p = 0; p < MAX_PORTS; ++p)
+        {
+            h.andMask[p] = 0xFF;
+            h.orMask[p] = 0x00;
+        }
+        for (uint8_t i = 0; i < OUTPUT_MAX_CHANNELS; ++i)
+        {
+            if (!(src.edge[e].mask & (1u << i)))
+                continue;
+            if (src.edge[e].level)
+                h.orMask[gOutPort[i]] |= gOutBit[i];
+            else
+                h.andMask[gOutPort[i]] &= (uint8_t)~gOutBit[i];
+        }
+    }
+}
+
+// Arms compare A towards gNextAt; long gaps are split so the 16-bit
+// distance to the compare value stays unambiguous
+static inline void armFrom(uint16_t fromTick)
+{
+    const uint16_t wake = (uint16_t)(gNextAt - WAKE_LEAD_TICKS);
+    const uint16_t left = (uint16_t)(wake - fromTick);
+    gWakeAt = (left > LONG_WAIT_TICKS) ? (uint16_t)(fromTick + LONG_WAIT_TICKS) : wake;
+    OCR1A = gWakeAt;
+}
+
+ISR(TIMER1_COMPA_vect)
+{
+    // Intermediate wake-up of a long gap
+    if (gWakeAt != (uint16_t)(gNextAt - WAKE_LEAD_TICKS))
+    {
+        armFrom(gWakeAt);
+        return;
+    }
+
+    for (;;)
+    {
+        const uint16_t at = gNextAt;
+        const HwSchedule &s = gSched[gActive];
+
+        if (gEdge < s.edgeCount)
+        {
+            // Woken early on purpose: wait for the exact tick
+            const HwEdge &e = s.edge[gEdge];
+            while ((int16_t)(TCNT1 - at) < 0)
+            {
+            }
+            for (uint8_t p = 0; p < gPortCount; ++p)
+                *gPortReg[p] = (uint8_t)((*gPortReg[p] & e.andMask[p]) | e.orMask[p]);
+
+            gEdge++;
+            gNextAt = (uint16_t)(gFrameStart + (gEdge < s.edgeCount ? s.edge[gEdge].atTicks : s.frameTicks));
+        }
+        else
+        {
+            // Frame boundary: newest schedule takes over
+            gFrameStart = at;
+            if (gPending)
+            {
+                gActive = (uint8_t)(gActive ^ 1u);
+                gPending = false;
+            }
+            gEdge = 0;
+            const HwSchedule &n = gSched[gActive];
+            gNextAt = (uint16_t)(gFrameStart + (n.edgeCount ? n.edge[0].atTicks : n.frameTicks));
+        }
+
+        // Next edge close: handle it in this call rather than risk missing it
+        if ((uint16_t)(gNextAt - at) > (uint16_t)(WAKE_LEAD_TICKS + REARM_MIN_TICKS))
+        {
+            armFrom(at);
+            return;
+        }
+    }
+}
+
+bool outputInit(const OutputConfig &cfg)
+{
+    // Stop the timer before touching the schedules
+    TIMSK1 &= (uint8_t)~_BV(OCIE1A);
+    gRunning = false;
+
+    gCfg = cfg;
+    if ((uint8_t)gCfg.mode >= (uint8_t)OutputMode::Count || gCfg.count == 0 || gCfg.count > OUTPUT_MAX_CHANNELS)
+        return false;
+
+    if (gCfg.mode == OutputMode::Sbus)
+    {
+        Serial.begin(100000, SERIAL_8E2);
+        lastSbusUs = micros();
+        gRunning = true;
+        return true;
+    }
+
+    if (!mapPins())
+        return false;
+
+    // Empty frame until the first outputWrite()
+    gSched[0] = HwSchedule{};
+    gSched[0].frameTicks = (uint16_t)((gCfg.mode == OutputMode::Ppm ? OUTPUT_PPM_FRAME_US : pulsePwmFrameUs(gCfg.pwmRateHz)) *
+                                      TICKS_PER_US);
+    gActive = 0;
+    gPending = false;
+    gEdge = 0;
+
+    // Timer1 free-running (normal mode), clk/8, compare A drives the edges
+    TCCR1A = 0;
+    TCCR1B = _BV(CS11);
+    gFrameStart = TCNT1;
+    gNextAt = (uint16_t)(gFrameStart + gSched[0].frameTicks);
+    armFrom(gFrameStart);
+    TIFR1 = _BV(OCF1A);
+    TIMSK1 |= _BV(OCIE1A);
+    gRunning = true;
+    return true;
+}
+
+void outputWrite(const CommFrame &frame)
+{
+    if (!gRunning)
+        return;
+
+    uint16_t width[OUTPUT_MAX_CHANNELS];
+    for (uint8_t i = 0; i < gCfg.count; ++i)
+    {
+        const uint8_t ch = gCfg.channel[i];
+        width[i] = (ch < frame.channelCount && ch < COMM_MAX_CHANNELS) ? pulseChannelToUs(frame.ch[ch]) : 0;
+    }
+
+    if (gCfg.mode == OutputMode::Sbus)
+    {
+        // UART TX is interrupt driven: never wait for a full buffer
+        const uint32_t nowUs = micros();
+        if (nowUs - lastSbusUs < SBUS_PERIOD_US || Serial.availableForWrite() < OUTPUT_SBUS_FRAME_SIZE)
+            return;
+        lastSbusUs = nowUs;
+        uint8_t buf[OUTPUT_SBUS_FRAME_SIZE];
+        pulseBuildSbus(width, gCfg.count, buf);
+        Serial.write(buf, OUTPUT_SBUS_FRAME_SIZE);
+        return;
+    }
+
+    // Back buffer is still waiting for the ISR: the next call brings a fresher frame anyway
+    if (gPending)
+        return;
+
+    PulseSchedule s;
+    const bool ok = (gCfg.mode == OutputMode::Ppm) ? pulseBuildPpm(width, gCfg.count, s)
+                                                   : pulseBuildPwm(width, gCfg.count, pulsePwmFrameUs(gCfg.pwmRateHz), s);
+    if (!ok)
+        return;
+
+    toHw(s, gSched[gActive ^ 1u]);
+    gPending = true;
+}
+
+#else
+
+bool outputInit(const OutputConfig &cfg)
+{
+    (void)cfg;
+    return false;
+}
+
+void outputWrite(const CommFrame &frame)
+{
+    (void)frame;
+}
+
+#endif
@@ -0,0 +1,143 @@
+#include <receiver/pulse_schedule.h>
+
+uint16_t pulseChannelToUs(uint16_t ch)
+{
+    if (ch == COMM_CH_CUT)
+        return 0;
+    if (ch < COMM_CH_MIN)
+        ch = COMM_CH_MIN;
+    if (ch > COMM_CH_MAX)
+        ch = COMM_CH_MAX;
+
+    const int32_t d = (int32_t)ch - COMM_CH_CENTER;
+    const int32_t half = COMM_CH_SPAN / 2;
+    const int32_t span = OUTPUT_PULSE_MAX_US - OUTPUT_PULSE_CENTER_US;
+    return (uint16_t)(OUTPUT_PULSE_CENTER_US + (d * span + (d >= 0 ? half : -half)) / COMM_CH_SPAN);
+}
+
+uint16_t pulsePwmFrameUs(uint16_t rateHz)
+{
+    if (rateHz < OUTPUT_PWM_RATE_MIN_HZ)
+        rateHz = OUTPUT_PWM_RATE_MIN_HZ;
+    if (rateHz > OUTPUT_PWM_RATE_MAX_HZ)
+        rateHz = OUTPUT_PWM_RATE_MAX_HZ;
+    return (uint16_t)((1000000UL + rateHz / 2U) / rateHz);
+}
+
+static uint16_t clampPulse(uint16_t us)
+{
+    if (us == 0)
+        return OUTPUT_PULSE_MIN_US;
+    if (us < OUTPUT_PULSE_MIN_US)
+        return OUTPUT_PULSE_MIN_US;
+    if (us > OUTPUT_PULSE_MAX_US)
+        return OUTPUT_PULSE_MAX_US;
+    return us;
+}
+
+bool pulseBuildPwm(const uint16_t *widthUs, uint8_t count, uint16_t frameUs, PulseSchedule &out)
+{
+    out.edgeCount = 0;
+    out.frameUs = frameUs;
+    if (count > OUTPUT_MAX_CHANNELS || frameUs < OUTPUT_PULSE_MAX_US + OUTPUT_PWM_GAP_MIN_US)
+        return false;
+
+    // Rising edge for every output with a pulse
+    uint8_t rise = 0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        if (widthUs[i] != 0)
+            rise = (uint8_t)(rise | (1u << i));
+    }
+    if (rise == 0)
+        return true;
+    out.edge[out.edgeCount++] = PulseEdge{0, rise, 1};
+
+    // Falling edges in time order, equal widths merged (selection: count is tiny)
+    uint8_t pending = rise;
+    while (pending)
+    {
+        uint16_t at = 0xFFFF;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if ((pending & (1u << i)) && clampPulse(widthUs[i]) < at)
+                at = clampPulse(widthUs[i]);
+        }
+
+        uint8_t mask = 0;
+        for (uint8_t i = 0; i < count; ++i)
+        {
+            if ((pending & (1u << i)) && clampPulse(widthUs[i]) == at)
+                mask = (uint8_t)(mask | (1u << i));
+        }
+        pending = (uint8_t)(pending & ~mask);
+        out.edge[out.edgeCount++] = PulseEdge{at, mask, 0};
+    }
+    return true;
+}
+
+bool pulseBuildPpm(const uint16_t *widthUs, uint8_t count, PulseSchedule &out)
+{
+    out.edgeCount = 0;
+    out.frameUs = OUTPUT_PPM_FRAME_US;
+    if (count == 0 || count > OUTPUT_MAX_CHANNELS)
+        return false;
+
+    bool anyLive = false;
+    for (uint8_t i = 0; i < count; ++i)
+        anyLive = anyLive || widthUs[i] != 0;
+    if (!anyLive)
+        return true; // train stops: receiver side sees signal loss
+
+    uint32_t t = 0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        out.edge[out.edgeCount++] = PulseEdge{(uint16_t)t, 1u, 0};
+        out.edge[out.edgeCount++] = PulseEdge{(uint16_t)(t + OUTPUT_PPM_SYNC_US), 1u, 1};
+        t += clampPulse(widthUs[i]);
+    }
+    // Closing sync pulse marks the end of the last channel
+    out.edge[out.edgeCount++] = PulseEdge{(uint16_t)t, 1u, 0};
+    out.edge[out.edgeCount++] = PulseEdge{(uint16_t)(t + OUTPUT_PPM_SYNC_US), 1u, 1};
+
+    // Long channels stretch the frame to keep the sync gap
+    if (t + OUTPUT_PPM_GAP_MIN_US > out.frameUs)
+        out.frameUs = (uint16_t)(t + OUTPUT_PPM_GAP_MIN_US);
+    return true;
+}
+
+void pulseBuildSbus(const uint16_t *widthUs, uint8_t count, uint8_t out[OUTPUT_SBUS_FRAME_SIZE])
+{
+    for (uint8_t i = 0; i < OUTPUT_SBUS_FRAME_SIZE; ++i)
+        out[i] = 0;
+    out[0] = 0x0F;
+
+    bool anyLive = false;
+    uint32_t acc = 0;
+    uint8_t bits = 0;
+    uint8_t pos = 1;
+    for (uint8_t i = 0; i < OUTPUT_SBUS_CHANNELS; ++i)
+    {
+        // us = 880 + 5/8 v: 1000..2000 us <-> 192..1792, 1500 us = 992
+        uint16_t v = 992;
+        if (i < count)
+        {
+            anyLive = anyLive || widthUs[i] != 0;
+            const int32_t us = clampPulse(widthUs[i]);
+            v = (uint16_t)(992 + ((us - 1500) * 8 + (us >= 1500 ? 2 : -2)) / 5);
+        }
+
+        // 11 bits per channel, LSB first
+        acc |= (uint32_t)(v & 0x07FFu) << bits;
+        bits = (uint8_t)(bits + 11u);
+        while (bits >= 8)
+        {
+            out[pos++] = (uint8_t)acc;
+            acc >>= 8;
+            bits = (uint8_t)(bits - 8u);
+        }
+    }
+
+    out[23] = anyLive ? 0 : (uint8_t)(OUTPUT_SBUS_FLAG_FAILSAFE | OUTPUT_SBUS_FLAG_FRAME_LOST);
+    out[24] = 0x00;
+}
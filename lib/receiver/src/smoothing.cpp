@@ -0,0 +1,192 @@
+#include <receiver/smoothing.h>
+#include <math.h>
+
+// Damped filter state in 1/16 channel steps, coefficient in Q16
+static const uint8_t STATE_SHIFT = 4;
+static const uint32_t DAMPED_STEP_US = 1000UL; // filter runs at 1 kHz, independent of loop rate
+
+struct SmoothChannel
+{
+    uint16_t prev; // frame before the latest
+    uint16_t last; // latest frame
+    int32_t y1;    // damped: first pole
+    int32_t y2;    // damped: output
+    uint16_t alphaQ16;
+};
+
+static SmoothConfig gCfg{};
+static SmoothChannel gCh[COMM_MAX_CHANNELS];
+static uint8_t gChannelCount = COMM_CH_DEFAULT_COUNT;
+static uint32_t gIntervalUs = 20000UL;
+static uint32_t gPrevUs = 0;
+static uint32_t gLastUs = 0;
+static uint32_t gStepUs = 0;
+static uint8_t gFrames = 0; // frames since reset, saturates at 2
+
+static void updateCoefficients()
+{
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+    {
+        // One pole: alpha = 1 - exp(-step / tau)
+        const float tauUs = (float)gIntervalUs * (float)gCfg.strength[i] / 100.0f;
+        float alpha = 1.0f;
+        if (tauUs > (float)DAMPED_STEP_US)
+            alpha = 1.0f - expf(-(float)DAMPED_STEP_US / tauUs);
+        gCh[i].alphaQ16 = (uint16_t)(alpha >= 1.0f ? 65535.0f : alpha * 65536.0f);
+    }
+}
+
+void smoothInit(uint32_t intervalUs)
+{
+    gCfg = SmoothConfig{};
+    gIntervalUs = intervalUs ? intervalUs : 1;
+    smoothReset();
+    updateCoefficients();
+}
+
+void smoothSetInterval(uint32_t intervalUs)
+{
+    if (intervalUs == 0 || intervalUs == gIntervalUs)
+        return;
+    gIntervalUs = intervalUs;
+    updateCoefficients();
+}
+
+void smoothSetConfig(const SmoothConfig &cfg)
+{
+    gCfg = cfg;
+    if (gCfg.extrapFrames > SMOOTH_EXTRAP_FRAMES_MAX)
+        gCfg.extrapFrames = SMOOTH_EXTRAP_FRAMES_MAX;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+    {
+        if ((uint8_t)gCfg.mode[i] >= (uint8_t)SmoothMode::Count)
+            gCfg.mode[i] = SmoothMode::Off;
+    }
+    updateCoefficients();
+}
+
+const SmoothConfig &smoothGetConfig()
+{
+    return gCfg;
+}
+
+void smoothReset()
+{
+    gFrames = 0;
+}
+
+static int32_t linePosQ8(uint32_t sinceUs);
+static uint16_t clampChannel(int32_t v);
+
+void smoothOnFrame(const CommFrame &rx, uint32_t arrivalUs)
+{
+    // Where the line got to: the latest frame on time, further after lost frames
+    const int32_t posQ8 = (gFrames >= 2) ? linePosQ8(arrivalUs - gLastUs) - 256 : 0;
+
+    for (uint8_t i = 0; i < rx.channelCount && i < COMM_MAX_CHANNELS; ++i)
+    {
+        SmoothChannel &c = gCh[i];
+        const uint16_t v = rx.ch[i];
+        const bool fresh = (gFrames == 0) || c.last == COMM_CH_CUT || v == COMM_CH_CUT;
+        const int32_t delta = (int32_t)c.last - (int32_t)c.prev;
+        c.prev = fresh ? v : clampChannel((int32_t)c.last + ((delta * posQ8) >> 8));
+        c.last = v;
+        if (fresh)
+            c.y1 = c.y2 = (int32_t)v << STATE_SHIFT;
+    }
+    if (rx.channelCount > gChannelCount || gFrames == 0)
+        gChannelCount = rx.channelCount;
+
+    gPrevUs = (gFrames == 0) ? arrivalUs - gIntervalUs : gLastUs;
+    gLastUs = arrivalUs;
+    if (gFrames == 0)
+        gStepUs = arrivalUs;
+    if (gFrames < 2)
+        gFrames++;
+}
+
+// Position along the prev -> last line: 0 at the latest frame, 1 one interval later
+// (Q8, capped at 1 + extrapFrames)
+static int32_t linePosQ8(uint32_t sinceUs)
+{
+    const uint32_t capUs = gIntervalUs * (1UL + gCfg.extrapFrames);
+    if (sinceUs > capUs)
+        sinceUs = capUs;
+    return (int32_t)((sinceUs << 8) / gIntervalUs);
+}
+
+static uint16_t clampChannel(int32_t v)
+{
+    if (v < COMM_CH_MIN)
+        return COMM_CH_MIN;
+    if (v > COMM_CH_MAX)
+        return COMM_CH_MAX;
+    return (uint16_t)v;
+}
+
+void smoothUpdate(uint32_t nowUs, CommFrame &out)
+{
+    out.channelCount = gChannelCount;
+    if (gFrames == 0)
+    {
+        for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+            out.ch[i] = gCh[i].last;
+        return;
+    }
+
+    const uint32_t sinceUs = nowUs - gLastUs;
+
+    // Damped filter steps to catch up with (bounded after a long stall)
+    uint8_t steps = 0;
+    while (nowUs - gStepUs >= DAMPED_STEP_US && steps < 50)
+    {
+        gStepUs += DAMPED_STEP_US;
+        steps++;
+    }
+    if (nowUs - gStepUs >= DAMPED_STEP_US)
+        gStepUs = nowUs;
+
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+    {
+        SmoothChannel &c = gCh[i];
+        const int32_t delta = (int32_t)c.last - (int32_t)c.prev;
+
+        // Cut passes through untouched, so does everything before a second frame
+        if (c.last == COMM_CH_CUT || gFrames < 2)
+        {
+            out.ch[i] = c.last;
+            continue;
+        }
+
+        switch (gCfg.mode[i])
+        {
+        case SmoothMode::Linear:
+        {
+            // One interval behind: prev at the latest frame, last one interval later
+            const int32_t pos = linePosQ8(sinceUs) - 256;
+            out.ch[i] = clampChannel((int32_t)c.last + ((delta * pos) >> 8));
+            break;
+        }
+        case SmoothMode::Damped:
+        {
+            // Target runs ahead along the last slope while frames are missing
+            int32_t extra = linePosQ8(sinceUs) - 256;
+            if (extra < 0)
+                extra = 0;
+            const int32_t target = (int32_t)clampChannel((int32_t)c.last + ((delta * extra) >> 8)) << STATE_SHIFT;
+            // |error| < 2^15 and alpha < 2^16: the product fits int32 (no 64-bit math on AVR)
+            for (uint8_t s = 0; s < steps; ++s)
+            {
+                c.y1 += ((target - c.y1) * (int32_t)c.alphaQ16) >> 16;
+                c.y2 += ((c.y1 - c.y2) * (int32_t)c.alphaQ16) >> 16;
+            }
+            out.ch[i] = clampChannel((c.y2 + (1 << (STATE_SHIFT - 1))) >> STATE_SHIFT);
+            break;
+        }
+        case SmoothMode::Off:
+        default:
+            out.ch[i] = c.last;
+            break;
+        }
+    }
+}
@@ -0,0 +1,214 @@
+#include <Arduino.h>
+#include "controller/adc_sampler.h"
+#include "controller/config.h"
+
+#define ADC_SAMPLER_DEBUG 0 // 1 = print driver errors to Serial (USB), 0 = off
+
+// GP6/GP7 (ADC1_CH5/CH6) are the joystick buttons, read as digital inputs
+static const uint8_t kPins[] = {JOY_R_PIN_Y, JOY_R_PIN_X, JOY_L_PIN_Y, JOY_L_PIN_X, PHOTO_PIN, BATTERY_PIN};
+static const uint8_t kPinCount = sizeof(kPins) / sizeof(kPins[0]);
+
+#define ADC_OVERSAMPLE (1u << (2 * ADC_OVERSAMPLE_BITS))
+
+#if !defined(ESP_ARDUINO_VERSION_MAJOR) || ESP_ARDUINO_VERSION_MAJOR < 3
+#error "adc_sampler needs the continuous ADC driver of Arduino-ESP32 core 3 (see platformio.ini)"
+#endif
+
+#include "esp_adc/adc_continuous.h"
+#include "esp_adc/adc_cali.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_timer.h"
+#include "common/seqlock.h"
+
+#define ADC_SAMPLER_CHANNELS SOC_ADC_CHANNEL_NUM(0) // ADC1
+#define ADC_SAMPLER_BYTES_PER_CONV SOC_ADC_DIGI_RESULT_BYTES
+// One DMA frame = ADC_OVERSAMPLE conversions of every input
+#define ADC_SAMPLER_FRAME_BYTES (kPinCount * ADC_OVERSAMPLE * ADC_SAMPLER_BYTES_PER_CONV)
+#define ADC_SAMPLER_READY_TIMEOUT_MS 20
+
+static adc_continuous_handle_t gAdc = nullptr;
+static adc_cali_handle_t gCali = nullptr;
+
+// Averages in ADC_BITS + ADC_OVERSAMPLE_BITS with the time they were
+// converted, so a reader knows how old a value is rather than when it
+// happened to read it.
+struct AdcPublished
+{
+    uint32_t value[ADC_SAMPLER_CHANNELS];
+    uint32_t atUs[ADC_SAMPLER_CHANNELS]; // micros(), middle of the averaging window
+    uint32_t mask;                       // bit per channel, set on first value
+};
+
+// The ISR fills gIsrOut and publishes it once per DMA frame
+static Seqlock<AdcPublished> gOut;
+static AdcPublished gIsrOut;
+
+// ISR-only accumulators
+static uint32_t gSum[ADC_SAMPLER_CHANNELS];
+static uint16_t gCount[ADC_SAMPLER_CHANNELS];
+static uint32_t gFirstUs[ADC_SAMPLER_CHANNELS]; // first conversion of the running average
+
+static int8_t gChannelOfPin[SOC_GPIO_PIN_COUNT];
+
+static bool IRAM_ATTR onConvDone(adc_continuous_handle_t, const adc_continuous_evt_data_t *edata, void *)
+{
+    // The frame interrupt follows its last conversion; earlier ones are
+    // one conversion period apart (esp_timer is the micros() clock)
+    const uint32_t endUs = (uint32_t)esp_timer_get_time();
+    const uint32_t convs = edata->size / ADC_SAMPLER_BYTES_PER_CONV;
+    const uint8_t *buf = edata->conv_frame_buffer;
+    bool changed = false;
+    for (uint32_t k = 0; k < convs; ++k)
+    {
+        const adc_digi_output_data_t *d = (const adc_digi_output_data_t *)&buf[k * ADC_SAMPLER_BYTES_PER_CONV];
+        const uint32_t ch = d->type2.channel;
+        if (d->type2.unit != 0 || ch >= ADC_SAMPLER_CHANNELS)
+            continue;
+
+        const uint32_t atUs = endUs - ((convs - 1 - k) * 1000000UL) / ADC_SAMPLE_RATE_HZ;
+        if (gCount[ch] == 0)
+            gFirstUs[ch] = atUs;
+        gSum[ch] += d->type2.data;
+        if (++gCount[ch] < ADC_OVERSAMPLE)
+            continue;
+
+        // sum of 4^n conversions >> n -> n extra bits
+        gIsrOut.value[ch] = gSum[ch] >> ADC_OVERSAMPLE_BITS;
+        gIsrOut.atUs[ch] = gFirstUs[ch] + (atUs - gFirstUs[ch]) / 2;
+        gIsrOut.mask |= (1u << ch);
+        gSum[ch] = 0;
+        gCount[ch] = 0;
+        changed = true;
+    }
+    if (changed)
+        gOut.write(gIsrOut);
+    return false;
+}
+
+static bool startDma()
+{
+    adc_continuous_handle_cfg_t handleCfg{};
+    // Values are taken in the frame ISR; the driver's pool is never read,
+    // so it stays at the minimum size (a full pool only drops its copy).
+    handleCfg.max_store_buf_size = ADC_SAMPLER_FRAME_BYTES;
+    handleCfg.conv_frame_size = ADC_SAMPLER_FRAME_BYTES;
+    if (adc_continuous_new_handle(&handleCfg, &gAdc) != ESP_OK)
+        return false;
+
+    adc_digi_pattern_config_t pattern[kPinCount]{};
+    uint8_t patternCount = 0;
+    for (uint8_t i = 0; i < kPinCount; ++i)
+    {
+        adc_unit_t unit;
+        adc_channel_t channel;
+        if (adc_continuous_io_to_channel(kPins[i], &unit, &channel) != ESP_OK || unit != ADC_UNIT_1)
+            continue;
+
+        gChannelOfPin[kPins[i]] = (int8_t)channel;
+        pattern[patternCount].atten = ADC_ATTEN_DB_12;
+        pattern[patternCount].channel = (uint8_t)channel;
+        pattern[patternCount].unit = ADC_UNIT_1;
+        pattern[patternCount].bit_width = ADC_BITS;
+        ++patternCount;
+    }
+
+    adc_continuous_config_t cfg{};
+    cfg.pattern_num = patternCount;
+    cfg.adc_pattern = pattern;
+    cfg.sample_freq_hz = ADC_SAMPLE_RATE_HZ;
+    cfg.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    cfg.format = ADC_DIGI_OUTPUT_FORMAT_TYPE2;
+    if (adc_continuous_config(gAdc, &cfg) != ESP_OK)
+        return false;
+
+    adc_continuous_evt_cbs_t cbs{};
+    cbs.on_conv_done = onConvDone;
+    if (adc_continuous_register_event_callbacks(gAdc, &cbs, nullptr) != ESP_OK)
+        return false;
+
+    return adc_continuous_start(gAdc) == ESP_OK;
+}
+
+static void initCalibration()
+{
+    adc_cali_curve_fitting_config_t caliCfg{};
+    caliCfg.unit_id = ADC_UNIT_1;
+    caliCfg.atten = ADC_ATTEN_DB_12;
+    caliCfg.bitwidth = (adc_bitwidth_t)ADC_BITS;
+    if (adc_cali_create_scheme_curve_fitting(&caliCfg, &gCali) != ESP_OK)
+        gCali = nullptr;
+}
+
+void adcSamplerInit()
+{
+    for (uint8_t i = 0; i < sizeof(gChannelOfPin); ++i)
+        gChannelOfPin[i] = -1;
+
+    initCalibration();
+    if (!startDma())
+    {
+#if ADC_SAMPLER_DEBUG
+        Serial.println("[ADC] continuous mode start failed");
+#endif
+        return;
+    }
+
+    // Wait for the first average of every input so early reads are valid
+    uint32_t wanted = 0;
+    for (uint8_t i = 0; i < kPinCount; ++i)
+    {
+        if (gChannelOfPin[kPins[i]] >= 0)
+            wanted |= (1u << gChannelOfPin[kPins[i]]);
+    }
+    const uint32_t startMs = millis();
+    while ((gOut.read().mask & wanted) != wanted && millis() - startMs < ADC_SAMPLER_READY_TIMEOUT_MS)
+        delay(1);
+}
+
+static uint16_t hiResToRaw(uint32_t hiRes)
+{
+    const uint32_t v = (hiRes + (1u << (ADC_OVERSAMPLE_BITS - 1))) >> ADC_OVERSAMPLE_BITS;
+    return (v > ADC_MAX) ? ADC_MAX : (uint16_t)v;
+}
+
+uint16_t adcSamplerRawHiRes(uint8_t pin)
+{
+    if (pin >= SOC_GPIO_PIN_COUNT || gChannelOfPin[pin] < 0)
+        return 0;
+    return (uint16_t)gOut.read().value[gChannelOfPin[pin]];
+}
+
+uint16_t adcSamplerRaw(uint8_t pin)
+{
+    return hiResToRaw(adcSamplerRawHiRes(pin));
+}
+
+uint32_t adcSamplerReadRaw(const uint8_t *pins, uint8_t count, uint16_t *out)
+{
+    const AdcPublished p = gOut.read();
+    const uint32_t nowUs = micros();
+    uint32_t oldestAgeUs = 0;
+    for (uint8_t i = 0; i < count; ++i)
+    {
+        const int8_t ch = (pins[i] < SOC_GPIO_PIN_COUNT) ? gChannelOfPin[pins[i]] : -1;
+        if (ch < 0)
+        {
+            out[i] = 0;
+            continue;
+        }
+        out[i] = hiResToRaw(p.value[ch]);
+        const uint32_t ageUs = nowUs - p.atUs[ch];
+        if (ageUs > oldestAgeUs)
+            oldestAgeUs = ageUs;
+    }
+    return nowUs - oldestAgeUs;
+}
+
+uint32_t adcSamplerMilliVolts(uint8_t pin)
+{
+    const uint16_t raw = adcSamplerRaw(pin);
+    int mv = 0;
+    if (gCali && adc_cali_raw_to_voltage(gCali, raw, &mv) == ESP_OK)
+        return (mv < 0) ? 0 : (uint32_t)mv;
+    return (uint32_t)raw * 3100UL / ADC_MAX; // nominal 12 dB full scale
+}
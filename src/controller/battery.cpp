@@ -1,9 +1,9 @@
 #include <Arduino.h>
 #include "controller/battery.h"
 #include "controller/config.h"
+#include "controller/adc_sampler.h"
 
 static BatteryReading gBattery{0, 0, false};
-static uint32_t lastReadMs = 0;
 
 static uint8_t batteryPctFromMv(uint32_t mv)
 {
@@ -18,13 +18,7 @@ static uint8_t batteryPctFromMv(uint32_t mv)
 
 static uint32_t readBatteryMillivolts()
 {
-    uint32_t adcMvSum = 0;
-    for (uint8_t i = 0; i < BATTERY_AVG_SAMPLES; ++i)
-    {
-        adcMvSum += (uint32_t)analogReadMilliVolts(BATTERY_PIN);
-    }
-
-    const uint32_t adcMv = adcMvSum / BATTERY_AVG_SAMPLES;
+    const uint32_t adcMv = adcSamplerMilliVolts(BATTERY_PIN); // already averaged
 
     return (adcMv * (BATTERY_DIVIDER_R_TOP_OHM + BATTERY_DIVIDER_R_BOTTOM_OHM) + (BATTERY_DIVIDER_R_BOTTOM_OHM / 2UL)) /
            BATTERY_DIVIDER_R_BOTTOM_OHM;
@@ -32,20 +26,11 @@ static uint32_t readBatteryMillivolts()
 
 void batteryInit()
 {
-    pinMode(BATTERY_PIN, INPUT);
-    analogReadResolution(ADC_BITS);
-    lastReadMs = 0;
     gBattery = {0, 0, false};
 }
 
 void batteryTick()
 {
-    const uint32_t now = millis();
-    if (now - lastReadMs < BATTERY_READ_INTERVAL_MS)
-        return;
-
-    lastReadMs = now;
-
     const uint32_t millivolts = readBatteryMillivolts();
     gBattery.millivolts = (millivolts > 0xFFFFUL) ? 0xFFFFU : (uint16_t)millivolts;
     gBattery.percent = batteryPctFromMv(gBattery.millivolts);
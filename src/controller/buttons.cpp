@@ -1,34 +1,52 @@
 #include <Arduino.h>
+#include "soc/soc.h"
+#include "soc/gpio_reg.h"
 #include "controller/buttons.h"
 #include "controller/config.h"
 
-static const unsigned long debounceMs = 30;
 static const bool BUTTONS_MONITOR = (PERF_DEBUG != 0);
 static const uint8_t KEY_SLOT_COUNT = (uint8_t)Key::JR + 1;
 
-
 static inline uint8_t idx(Key k) { return (uint8_t)k; }
+static inline uint16_t bit(uint8_t i) { return (uint16_t)(1u << i); }
+
+// GPIO per key slot, 0xFF = none (Key::None)
+static const uint8_t kKeyPins[KEY_SLOT_COUNT] = {
+    0xFF,
+    BUTTON_LEFT_PIN,
+    BUTTON_RIGHT_PIN,
+    BUTTON_UP_PIN,
+    BUTTON_DOWN_PIN,
+    BUTTON_CENTER_PIN,
+    BUTTON_F1_PIN,
+    BUTTON_F2_PIN,
+    JOY_L_PIN_BTN,
+    JOY_R_PIN_BTN};
 
 struct Engine
 {
-    Key lastReading = Key::None;
-    Key stable = Key::None;
-    unsigned long lastChange = 0;
-    unsigned long pressStart = 0;
-    bool releasedPending[KEY_SLOT_COUNT] = {};
+    // Debounce: 2-bit vertical counter per key, a key flips after
+    // 4 samples in a row that differ from its stable state
+    uint16_t stable = 0;
+    uint16_t ct0 = 0xFFFF;
+    uint16_t ct1 = 0xFFFF;
+
+    unsigned long pressStart[KEY_SLOT_COUNT] = {};
+    uint16_t releasedPending = 0;
+    uint16_t shortPending = 0;
+    uint16_t longFired = 0;   // query API (keyLongPress)
+    uint16_t longQueued = 0;  // event queue
     uint32_t releaseDur[KEY_SLOT_COUNT] = {};
-    bool shortPending[KEY_SLOT_COUNT] = {};
-    bool longFired[KEY_SLOT_COUNT] = {};
     unsigned long lastRepeatAt[KEY_SLOT_COUNT] = {};
+    unsigned long lastEventRepeatAt[KEY_SLOT_COUNT] = {};
 };
 
 static Engine eng;
 static Key lastReleaseKey = Key::None;
 
-static inline bool isPhysicalPressed(uint8_t pin)
-{
-    return digitalRead(pin) == LOW;
-}
+static ButtonEvent gEvents[BUTTONS_EVENT_QUEUE];
+static uint8_t gEventHead = 0; // next write
+static uint8_t gEventCount = 0;
 
 static const char *keyName(Key k)
 {
@@ -57,185 +75,167 @@ static const char *keyName(Key k)
     }
 }
 
-static void resetPerPressState(Key k)
-{
-    const uint8_t i = idx(k);
-    if (i >= KEY_SLOT_COUNT)
-        return;
-    eng.longFired[i] = false;
-    eng.lastRepeatAt[i] = 0;
-}
-
-static Key selectFirstPressed(Key preferred)
+// All keys from one read of each GPIO input register, bit set = pressed (active low)
+static uint16_t readPressedMask()
 {
-    switch (preferred)
+    const uint32_t in0 = REG_READ(GPIO_IN_REG);  // GPIO 0..31
+    const uint32_t in1 = REG_READ(GPIO_IN1_REG); // GPIO 32..
+    uint16_t mask = 0;
+    for (uint8_t i = 1; i < KEY_SLOT_COUNT; ++i)
     {
-    case Key::Left:
-        if (isPhysicalPressed(BUTTON_LEFT_PIN))
-            return preferred;
-        break;
-    case Key::Right:
-        if (isPhysicalPressed(BUTTON_RIGHT_PIN))
-            return preferred;
-        break;
-    case Key::Up:
-        if (isPhysicalPressed(BUTTON_UP_PIN))
-            return preferred;
-        break;
-    case Key::Down:
-        if (isPhysicalPressed(BUTTON_DOWN_PIN))
-            return preferred;
-        break;
-    case Key::Center:
-        if (isPhysicalPressed(BUTTON_CENTER_PIN))
-            return preferred;
-        break;
-    case Key::F1:
-        if (isPhysicalPressed(BUTTON_F1_PIN))
-            return preferred;
-        break;
-    case Key::F2:
-        if (isPhysicalPressed(BUTTON_F2_PIN))
-            return preferred;
-        break;
-    case Key::JL:
-        if (isPhysicalPressed(JOY_L_PIN_BTN))
-            return preferred;
-        break;
-    case Key::JR:
-        if (isPhysicalPressed(JOY_R_PIN_BTN))
-            return preferred;
-        break;
-    default:
-        break;
+        const uint8_t pin = kKeyPins[i];
+        const uint32_t level = (pin < 32) ? (in0 >> pin) : (in1 >> (pin - 32));
+        if ((level & 1u) == 0)
+            mask |= bit(i);
     }
+    return mask;
+}
 
-    if (isPhysicalPressed(BUTTON_UP_PIN))
-        return Key::Up;
-    if (isPhysicalPressed(BUTTON_DOWN_PIN))
-        return Key::Down;
-    if (isPhysicalPressed(BUTTON_LEFT_PIN))
-        return Key::Left;
-    if (isPhysicalPressed(BUTTON_RIGHT_PIN))
-        return Key::Right;
-    if (isPhysicalPressed(BUTTON_CENTER_PIN))
-        return Key::Center;
-    if (isPhysicalPressed(BUTTON_F1_PIN))
-        return Key::F1;
-    if (isPhysicalPressed(BUTTON_F2_PIN))
-        return Key::F2;
-    if (isPhysicalPressed(JOY_L_PIN_BTN))
-        return Key::JL;
-    if (isPhysicalPressed(JOY_R_PIN_BTN))
-        return Key::JR;
-    return Key::None;
+// Full queue drops the oldest event
+static void pushEvent(Key k, ButtonEventType type, uint32_t atMs, uint32_t heldMs)
+{
+    ButtonEvent &ev = gEvents[gEventHead];
+    ev.atMs = atMs;
+    ev.heldMs = heldMs;
+    ev.key = k;
+    ev.type = type;
+    gEventHead = (uint8_t)((gEventHead + 1) % BUTTONS_EVENT_QUEUE);
+    if (gEventCount < BUTTONS_EVENT_QUEUE)
+        ++gEventCount;
 }
 
-static void buttonsUpdate()
+static void onPressed(uint8_t i, uint32_t now)
 {
-    const Key reading = selectFirstPressed(eng.stable);
+    eng.pressStart[i] = now;
+    eng.longFired &= (uint16_t)~bit(i);
+    eng.longQueued &= (uint16_t)~bit(i);
+    eng.lastRepeatAt[i] = 0;
+    pushEvent((Key)i, ButtonEventType::Press, now, 0);
 
-    if (reading != eng.lastReading)
+    if (BUTTONS_MONITOR)
     {
-        eng.lastChange = millis();
-        eng.lastReading = reading;
+        Serial.print("[BTN] PRESSED  ");
+        Serial.println(keyName((Key)i));
     }
+}
 
-    if ((millis() - eng.lastChange) <= debounceMs)
-        return;
+static void onReleased(uint8_t i, uint32_t now)
+{
+    const uint32_t dur = (eng.pressStart[i] != 0) ? (uint32_t)(now - eng.pressStart[i]) : 0;
+    eng.pressStart[i] = 0;
+    eng.releaseDur[i] = dur;
+    eng.releasedPending |= bit(i);
+    if (!(eng.longFired & bit(i)))
+        eng.shortPending |= bit(i);
+    lastReleaseKey = (Key)i;
+    pushEvent((Key)i, ButtonEventType::Release, now, dur);
+
+    if (BUTTONS_MONITOR)
+    {
+        Serial.print("[BTN] RELEASED ");
+        Serial.print(keyName((Key)i));
+        Serial.print("  dur=");
+        Serial.print(dur);
+        Serial.println(" ms");
+    }
+}
 
-    if (reading == eng.stable)
+static void sample(uint32_t now)
+{
+    const uint16_t changed = readPressedMask() ^ eng.stable;
+    eng.ct0 = (uint16_t)~(eng.ct0 & changed);
+    eng.ct1 = (uint16_t)(eng.ct0 ^ (eng.ct1 & changed));
+    const uint16_t flip = changed & eng.ct0 & eng.ct1;
+    if (flip == 0)
         return;
 
-    const Key prev = eng.stable;
-    eng.stable = reading;
-
-    if (prev == Key::None && eng.stable != Key::None)
+    eng.stable ^= flip;
+    for (uint8_t i = 1; i < KEY_SLOT_COUNT; ++i)
     {
-        eng.pressStart = millis();
-        resetPerPressState(eng.stable);
-
-        if (BUTTONS_MONITOR)
-        {
-            Serial.print("[BTN] PRESSED  ");
-            Serial.println(keyName(eng.stable));
-        }
-        return;
+        if (!(flip & bit(i)))
+            continue;
+        if (eng.stable & bit(i))
+            onPressed(i, now);
+        else
+            onReleased(i, now);
     }
+}
 
-    if (prev != Key::None)
+// Long / repeat events for held keys
+static void queueHoldEvents(uint32_t now)
+{
+    uint16_t held = eng.stable;
+    while (held)
     {
-        const uint8_t ip = idx(prev);
-        uint32_t dur = 0;
-        if (eng.pressStart != 0)
-            dur = (uint32_t)(millis() - eng.pressStart);
-
-        if (ip < KEY_SLOT_COUNT)
-        {
-            eng.releaseDur[ip] = dur;
-            eng.releasedPending[ip] = true;
-            if (!eng.longFired[ip])
-                eng.shortPending[ip] = true;
-        }
-
-        lastReleaseKey = prev;
+        const uint8_t i = (uint8_t)__builtin_ctz(held);
+        held &= (uint16_t)(held - 1);
+        if (eng.pressStart[i] == 0)
+            continue; // held across buttonsConsumeAll()
 
-        if (BUTTONS_MONITOR)
+        const uint32_t dur = (uint32_t)(now - eng.pressStart[i]);
+        if (!(eng.longQueued & bit(i)))
         {
-            Serial.print("[BTN] RELEASED ");
-            Serial.print(keyName(prev));
-            Serial.print("  dur=");
-            Serial.print(dur);
-            Serial.println(" ms");
+            if (dur >= BUTTONS_LONG_MS)
+            {
+                eng.longQueued |= bit(i);
+                eng.lastEventRepeatAt[i] = now;
+                pushEvent((Key)i, ButtonEventType::Long, now, dur);
+            }
         }
-    }
-
-    if (eng.stable != Key::None)
-    {
-        eng.pressStart = millis();
-        resetPerPressState(eng.stable);
-
-        if (BUTTONS_MONITOR)
+        else if (now - eng.lastEventRepeatAt[i] >= BUTTONS_REPEAT_MS)
         {
-            Serial.print("[BTN] PRESSED  ");
-            Serial.println(keyName(eng.stable));
+            eng.lastEventRepeatAt[i] = now;
+            pushEvent((Key)i, ButtonEventType::Repeat, now, dur);
         }
     }
-    else
-    {
-        eng.pressStart = 0;
-    }
 }
 
 void buttonsInit()
 {
-    pinMode(BUTTON_UP_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_DOWN_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_LEFT_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_RIGHT_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_CENTER_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_F1_PIN, INPUT_PULLUP);
-    pinMode(BUTTON_F2_PIN, INPUT_PULLUP);
-    pinMode(JOY_L_PIN_BTN, INPUT_PULLUP);
-    pinMode(JOY_R_PIN_BTN, INPUT_PULLUP);
+    for (uint8_t i = 1; i < KEY_SLOT_COUNT; ++i)
+        pinMode(kKeyPins[i], INPUT_PULLUP);
 
     eng = Engine{};
+    gEventHead = 0;
+    gEventCount = 0;
+}
+
+void buttonsTick()
+{
+    const uint32_t now = millis();
+    sample(now);
+    queueHoldEvents(now);
+}
+
+bool buttonsPollEvent(ButtonEvent &ev)
+{
+    if (gEventCount == 0)
+        return false;
+    const uint8_t tail = (uint8_t)((gEventHead + BUTTONS_EVENT_QUEUE - gEventCount) % BUTTONS_EVENT_QUEUE);
+    ev = gEvents[tail];
+    --gEventCount;
+    return true;
 }
 
 bool keyDown(Key k)
 {
-    buttonsUpdate();
-    return eng.stable == k;
+    return (eng.stable & bit(idx(k))) != 0;
+}
+
+uint16_t buttonsDownMask()
+{
+    return eng.stable;
+}
+
+bool keysHeld(uint16_t mask)
+{
+    return mask != 0 && (eng.stable & mask) == mask;
 }
 
 bool keyReleased(Key k, uint32_t *durationMs, bool consume)
 {
-    buttonsUpdate();
     const uint8_t i = idx(k);
-    if (i >= KEY_SLOT_COUNT)
-        return false;
-
-    if (!eng.releasedPending[i])
+    if (i >= KEY_SLOT_COUNT || !(eng.releasedPending & bit(i)))
         return false;
 
     if (durationMs)
@@ -243,8 +243,8 @@ bool keyReleased(Key k, uint32_t *durationMs, bool consume)
 
     if (consume)
     {
-        eng.releasedPending[i] = false;
-        eng.shortPending[i] = false;
+        eng.releasedPending &= (uint16_t)~bit(i);
+        eng.shortPending &= (uint16_t)~bit(i);
     }
     return true;
 }
@@ -256,24 +256,29 @@ Key buttonsLastReleaseKey()
 
 void buttonsConsumeAll()
 {
-    const Key current = eng.stable;
-    eng = Engine{};
-    eng.stable = current;
-    eng.lastReading = current;
+    // Held keys stay held (and debounced); their press is used up:
+    // no long/repeat until pressed again, the release still reports
+    eng.releasedPending = 0;
+    eng.shortPending = 0;
+    for (uint8_t i = 1; i < KEY_SLOT_COUNT; ++i)
+    {
+        if (eng.stable & bit(i))
+            eng.pressStart[i] = 0;
+    }
+    gEventCount = 0;
 }
 
 bool keyShortClick(Key k, uint32_t thresholdMs, bool consume)
 {
-    buttonsUpdate();
     const uint8_t i = idx(k);
-    if (i >= KEY_SLOT_COUNT || !eng.shortPending[i])
+    if (i >= KEY_SLOT_COUNT || !(eng.shortPending & bit(i)))
         return false;
 
     const bool isShort = (eng.releaseDur[i] < thresholdMs);
     if (consume)
     {
-        eng.shortPending[i] = false;
-        eng.releasedPending[i] = false;
+        eng.shortPending &= (uint16_t)~bit(i);
+        eng.releasedPending &= (uint16_t)~bit(i);
     }
     return isShort;
 }
@@ -284,41 +289,28 @@ bool keyLongPress(Key k,
                   uint32_t thresholdMs,
                   bool consume)
 {
-    buttonsUpdate();
-
-    if (k == Key::None || eng.stable != k || eng.pressStart == 0)
-        return false;
-
     const uint8_t i = idx(k);
-    if (i >= KEY_SLOT_COUNT)
+    if (k == Key::None || i >= KEY_SLOT_COUNT || !(eng.stable & bit(i)) || eng.pressStart[i] == 0)
         return false;
 
-    const uint32_t held = (uint32_t)(millis() - eng.pressStart);
+    const unsigned long now = millis();
+    const uint32_t held = (uint32_t)(now - eng.pressStart[i]);
     if (held < thresholdMs)
         return false;
 
-    if (!eng.longFired[i])
+    if (!(eng.longFired & bit(i)))
     {
         if (consume)
-            eng.longFired[i] = true;
-        eng.lastRepeatAt[i] = millis();
+            eng.longFired |= bit(i);
+        eng.lastRepeatAt[i] = now;
         return true;
     }
 
-    if (repeat)
+    if (repeat && now - eng.lastRepeatAt[i] >= repeatMs)
     {
-        const unsigned long now = millis();
-        if (now - eng.lastRepeatAt[i] >= repeatMs)
-        {
-            eng.lastRepeatAt[i] = now;
-            return true;
-        }
+        eng.lastRepeatAt[i] = now;
+        return true;
     }
 
     return false;
 }
-
-void buttonsTick()
-{
-    buttonsUpdate();
-}
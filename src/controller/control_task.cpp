@@ -0,0 +1,100 @@
+#include <Arduino.h>
+#include <atomic>
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include "controller/control_task.h"
+#include "controller/config.h"
+#include "controller/input_snapshot.h"
+#include "controller/joysticks.h"
+#include "controller/link_quality.h"
+#include "controller/receiver.h"
+#include "controller/tx_frame.h"
+
+static SemaphoreHandle_t gLock = nullptr;
+static TaskHandle_t gTask = nullptr;
+static esp_timer_handle_t gTimer = nullptr;
+static uint32_t gTimerPeriodUs = 0;
+
+static volatile uint32_t gTickUs = 0; // timer fire time of the latest tick
+// One decision of the UI core (menu + link gating), read once per tick
+static std::atomic<bool> gLive{false};
+
+void controlLock()
+{
+    // First use is in setup(), before the task exists
+    if (!gLock)
+        gLock = xSemaphoreCreateRecursiveMutex();
+    xSemaphoreTakeRecursive(gLock, portMAX_DELAY);
+}
+
+void controlUnlock()
+{
+    xSemaphoreGiveRecursive(gLock);
+}
+
+void controlSetLiveControls(bool live)
+{
+    gLive.store(live, std::memory_order_release);
+}
+
+// esp_timer task context
+static void onTimer(void *)
+{
+    gTickUs = micros();
+    xTaskNotifyGive(gTask);
+}
+
+static void startTimer(uint32_t periodUs)
+{
+    if (gTimerPeriodUs != 0)
+        esp_timer_stop(gTimer);
+    gTimerPeriodUs = periodUs;
+    esp_timer_start_periodic(gTimer, periodUs);
+    joysticksSetFilterRate(1000000UL / periodUs);
+}
+
+static void controlTaskMain(void *)
+{
+    for (;;)
+    {
+        // Notifications count timer ticks; the timeout paces the ACK polling
+        const uint32_t ticks = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(CONTROL_POLL_MS));
+
+        ControlLockGuard lock;
+        receiverPoll();
+        if (ticks == 0)
+            continue;
+
+        const uint32_t tickUs = gTickUs;
+        const uint32_t captureUs = micros();
+        const uint32_t convertedUs = inputCapture();
+        const CommFrame tx = txFrameBuild(gLive.load(std::memory_order_acquire));
+        if (receiverSend(tx, ticks))
+            linkQualityOnSend(micros() - convertedUs, captureUs - tickUs);
+
+        // Link profile changed: move the grid
+        const uint32_t periodUs = receiverGetTxPeriodUs();
+        if (periodUs != gTimerPeriodUs)
+            startTimer(periodUs);
+    }
+}
+
+void controlTaskStart()
+{
+    if (gTask)
+        return;
+
+    xTaskCreatePinnedToCore(controlTaskMain, "control", CONTROL_TASK_STACK, nullptr,
+                            CONTROL_TASK_PRIORITY, &gTask, CONTROL_TASK_CORE);
+
+    esp_timer_create_args_t args{};
+    args.callback = onTimer;
+    args.name = "control_tick";
+    esp_timer_create(&args, &gTimer);
+
+    ControlLockGuard lock;
+    startTimer(receiverGetTxPeriodUs());
+}
@@ -2,11 +2,20 @@
 #include <U8g2lib.h>
 #include <Wire.h>
 #include <string.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "common/seqlock.h"
 #include "controller/display.h"
 #include "controller/config.h"
 
-// SH1106 128x64 OLED via I2C, U8g2 page buffer.
-U8G2_SH1106_128X64_NONAME_1_HW_I2C oled(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
+#define DISPLAY_DEBUG 0 // 1 = print bytes sent per frame to Serial (USB), 0 = off
+
+// SH1106 128x64 OLED via I2C, U8g2 full frame buffer. Frames are rendered
+// into RAM and compared per 8x8 tile with what the panel already shows;
+// only changed tiles go over the bus. Used by the display task only
+// (after displayInit()).
+U8G2_SH1106_128X64_NONAME_F_HW_I2C oled(U8G2_R0, /* reset=*/U8X8_PIN_NONE);
 
 static const uint8_t kRows = 5;
 static const uint8_t kCols = 20;
@@ -16,6 +25,55 @@ static char lines[kRows][kCols + 1];
 // ============ Buffer state ============
 static bool dirty = false;
 
+// ============ Frame hand-over ============
+// One recorded overlay call. drawStr: a, b = position, c = pool offset.
+enum class DisplayOp : uint8_t
+{
+    DrawColor,
+    FontMode,
+    Box,
+    Line,
+    Str
+};
+
+struct DisplayCmd
+{
+    DisplayOp op;
+    uint8_t arg;
+    int16_t a, b, c, d;
+};
+
+struct DisplayFrame
+{
+    char lines[kRows][kCols + 1];
+    DisplayCmd cmd[DISPLAY_CMD_MAX];
+    uint16_t cmdCount;
+    uint16_t textUsed;
+    char text[DISPLAY_TEXT_POOL];
+};
+
+// Triple buffer: the UI fills slot uiSlot, the task draws slot taskSlot,
+// readySlot holds the latest published frame (+ kSlotNew until taken).
+// Each side only swaps its own slot with readySlot, so neither waits.
+static const uint8_t kSlotNew = 0x80;
+static DisplayFrame slots[3];
+static uint8_t uiSlot = 0;
+static std::atomic<uint8_t> readySlot{1};
+static uint8_t taskSlot = 2;
+
+static TaskHandle_t displayTask = nullptr;
+
+// Copy of the frame on the panel, same layout as the U8g2 buffer:
+// tile row by tile row, 8 bytes (columns) per tile
+static const uint8_t kTileCols = 16;
+static const uint8_t kTileRows = 8;
+static const uint8_t kTileBytes = 8;
+static uint8_t sentFrame[kTileCols * kTileRows * kTileBytes];
+static bool sentValid = false; // false: next frame goes out in full
+
+static DisplayStats stats{};            // display task
+static Seqlock<DisplayStats> statsOut;  // -> displayGetStats()
+
 // ============ OLED limiter ============
 static const uint32_t MIN_FLUSH_INTERVAL_MS = DISPLAY_MIN_FLUSH_INTERVAL_MS;
 static uint32_t lastFlushMs = 0;
@@ -26,8 +84,9 @@ static bool flushForceRequested = false;
 static DisplayOverlayFn overlayFn = nullptr;
 static void *overlayCtx = nullptr;
 
-// ============ Fault & recovery ============
+// ============ Fault & recovery (display task) ============
 static bool oledFault = false;
+static bool repaintNeeded = false;
 static uint32_t nextRecoverMs = 0;
 static uint8_t recoverAttempts = 0;
 
@@ -47,23 +106,184 @@ static void clearLines()
     dirty = true;
 }
 
-static void renderAll()
+// Sends the tiles that differ from sentFrame, one area per run of
+// changed tiles in a tile row. Returns the pixel bytes sent.
+static uint32_t sendChangedTiles(const uint8_t *buf)
 {
-    oled.firstPage();
-    do
+    if (!sentValid)
     {
-        for (uint8_t row = 0; row < kRows; ++row)
+        oled.sendBuffer();
+        memcpy(sentFrame, buf, sizeof(sentFrame));
+        sentValid = true;
+        return sizeof(sentFrame);
+    }
+
+    uint32_t bytes = 0;
+    for (uint8_t ty = 0; ty < kTileRows; ++ty)
+    {
+        uint8_t tx = 0;
+        while (tx < kTileCols)
         {
-            oled.drawStr(0, (row + 1) * kLineHeight, lines[row]);
+            const size_t off = ((size_t)ty * kTileCols + tx) * kTileBytes;
+            if (memcmp(&buf[off], &sentFrame[off], kTileBytes) == 0)
+            {
+                ++tx;
+                continue;
+            }
+
+            const uint8_t start = tx;
+            while (tx < kTileCols)
+            {
+                const size_t o = ((size_t)ty * kTileCols + tx) * kTileBytes;
+                if (memcmp(&buf[o], &sentFrame[o], kTileBytes) == 0)
+                    break;
+                ++tx;
+            }
+
+            const uint8_t w = (uint8_t)(tx - start);
+            oled.updateDisplayArea(start, ty, w, 1);
+            memcpy(&sentFrame[off], &buf[off], (size_t)w * kTileBytes);
+            bytes += (uint32_t)w * kTileBytes;
         }
-        // Draw overlay last so text (spaces) does not overwrite overlay lines.
-        if (overlayFn)
-            overlayFn(oled, overlayCtx);
-    } while (oled.nextPage());
+    }
+    return bytes;
+}
+
+static DisplayCmd *pushCmd(DisplayFrame &f, DisplayOp op)
+{
+    if (f.cmdCount >= DISPLAY_CMD_MAX)
+        return nullptr;
+    DisplayCmd *c = &f.cmd[f.cmdCount++];
+    c->op = op;
+    return c;
+}
+
+void DisplayCanvas::setDrawColor(uint8_t color)
+{
+    if (DisplayCmd *c = pushCmd(frame, DisplayOp::DrawColor))
+        c->arg = color;
+}
+
+void DisplayCanvas::setFontMode(uint8_t mode)
+{
+    if (DisplayCmd *c = pushCmd(frame, DisplayOp::FontMode))
+        c->arg = mode;
+}
+
+void DisplayCanvas::drawBox(int x, int y, int w, int h)
+{
+    if (DisplayCmd *c = pushCmd(frame, DisplayOp::Box))
+    {
+        c->a = (int16_t)x;
+        c->b = (int16_t)y;
+        c->c = (int16_t)w;
+        c->d = (int16_t)h;
+    }
+}
+
+void DisplayCanvas::drawLine(int x0, int y0, int x1, int y1)
+{
+    if (DisplayCmd *c = pushCmd(frame, DisplayOp::Line))
+    {
+        c->a = (int16_t)x0;
+        c->b = (int16_t)y0;
+        c->c = (int16_t)x1;
+        c->d = (int16_t)y1;
+    }
+}
+
+void DisplayCanvas::drawStr(int x, int y, const char *s)
+{
+    const size_t len = strlen(s) + 1;
+    if (frame.textUsed + len > DISPLAY_TEXT_POOL)
+        return;
+    if (DisplayCmd *c = pushCmd(frame, DisplayOp::Str))
+    {
+        c->a = (int16_t)x;
+        c->b = (int16_t)y;
+        c->c = (int16_t)frame.textUsed;
+        memcpy(&frame.text[frame.textUsed], s, len);
+        frame.textUsed = (uint16_t)(frame.textUsed + len);
+    }
+}
+
+// UI side: snapshot rows + overlay into the free slot and hand it over
+static void publishFrame()
+{
+    DisplayFrame &f = slots[uiSlot];
+    memcpy(f.lines, lines, sizeof(f.lines));
+    f.cmdCount = 0;
+    f.textUsed = 0;
+    if (overlayFn)
+    {
+        DisplayCanvas canvas(f);
+        overlayFn(canvas, overlayCtx);
+    }
+
+    uiSlot = readySlot.exchange((uint8_t)(uiSlot | kSlotNew), std::memory_order_acq_rel) & ~kSlotNew;
+    if (displayTask)
+        xTaskNotifyGive(displayTask);
 
     dirty = false;
 }
 
+// Display task: take the latest published frame, if any
+static bool takeFrame()
+{
+    if ((readySlot.load(std::memory_order_acquire) & kSlotNew) == 0)
+        return false;
+    taskSlot = readySlot.exchange(taskSlot, std::memory_order_acq_rel) & ~kSlotNew;
+    return true;
+}
+
+static void renderFrame(const DisplayFrame &f)
+{
+    oled.clearBuffer();
+    for (uint8_t row = 0; row < kRows; ++row)
+    {
+        oled.drawStr(0, (row + 1) * kLineHeight, f.lines[row]);
+    }
+    // Draw overlay last so text (spaces) does not overwrite overlay lines.
+    for (uint16_t i = 0; i < f.cmdCount; ++i)
+    {
+        const DisplayCmd &c = f.cmd[i];
+        switch (c.op)
+        {
+        case DisplayOp::DrawColor:
+            oled.setDrawColor(c.arg);
+            break;
+        case DisplayOp::FontMode:
+            oled.setFontMode(c.arg);
+            break;
+        case DisplayOp::Box:
+            oled.drawBox(c.a, c.b, c.c, c.d);
+            break;
+        case DisplayOp::Line:
+            oled.drawLine(c.a, c.b, c.c, c.d);
+            break;
+        case DisplayOp::Str:
+            oled.drawStr(c.a, c.b, &f.text[c.c]);
+            break;
+        }
+    }
+    // Overlays may leave other modes behind; text of the next frame expects these
+    oled.setDrawColor(1);
+    oled.setFontMode(0);
+
+    const uint32_t bytes = sendChangedTiles(oled.getBufferPtr());
+    stats.lastFrameBytes = bytes;
+    stats.totalBytes += bytes;
+    stats.frames++;
+    statsOut.write(stats);
+
+#if DISPLAY_DEBUG
+    Serial.print("[OLED] frame bytes=");
+    Serial.print(bytes);
+    Serial.print(" avg=");
+    Serial.println(stats.totalBytes / stats.frames);
+#endif
+}
+
 // ---- I2C "unstick" ----
 // Free the bus: 9 SCL clocks + STOP
 static void i2cUnstick()
@@ -109,13 +329,58 @@ static bool oledRecoverNow()
     oled.setBusClock(I2C_CLOCK_HZ);
     oled.setFont(u8g2_font_6x10_mr);
 
-    dirty = true;
-    flushRequested = true;
-    flushForceRequested = true;
+    sentValid = false; // panel content unknown after a reset
+    repaintNeeded = true;
 
     return true;
 }
 
+// Returns false while the panel is down (backoff running)
+static bool recoverIfFaulted()
+{
+    if (!oledFault)
+        return true;
+
+    const uint32_t now = millis();
+    if (now < nextRecoverMs)
+        return false;
+
+    if (recoverAttempts >= RECOVER_MAX_ATTEMPTS_BEFORE_LONG_PAUSE)
+    {
+        nextRecoverMs = now + RECOVER_LONG_PAUSE_MS;
+        recoverAttempts = 0;
+        return false;
+    }
+
+    recoverAttempts++;
+    bool ok = oledRecoverNow();
+    if (ok)
+    {
+        oledFault = false;
+        return true;
+    }
+    nextRecoverMs = now + RECOVER_BACKOFF_MS;
+    return false;
+}
+
+static void displayTaskMain(void *)
+{
+    for (;;)
+    {
+        // Woken per published frame; the timeout keeps recovery going
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(DISPLAY_TASK_IDLE_MS));
+
+        if (!recoverIfFaulted())
+            continue;
+
+        if (takeFrame() || repaintNeeded)
+        {
+            repaintNeeded = false;
+            renderFrame(slots[taskSlot]);
+        }
+    }
+}
+
 void displayInit()
 {
     oled.begin();
@@ -123,14 +388,25 @@ void displayInit()
     oled.setFont(u8g2_font_6x10_mr);
 
     clearLines();
+    for (DisplayFrame &f : slots)
+    {
+        memcpy(f.lines, lines, sizeof(f.lines));
+        f.cmdCount = 0;
+        f.textUsed = 0;
+    }
+    sentValid = false;
 
     flushRequested = true;
     flushForceRequested = true;
     lastFlushMs = millis();
 
     oledFault = false;
+    repaintNeeded = false;
     nextRecoverMs = 0;
     recoverAttempts = 0;
+
+    xTaskCreatePinnedToCore(displayTaskMain, "display", DISPLAY_TASK_STACK, nullptr,
+                            DISPLAY_TASK_PRIORITY, &displayTask, DISPLAY_TASK_CORE);
 }
 
 void displayClear()
@@ -185,45 +461,24 @@ void displayTick()
 {
     const uint32_t now = millis();
 
-    // 1) fault recovery
-    if (oledFault)
-    {
-        if (now < nextRecoverMs)
-            return;
-
-        if (recoverAttempts >= RECOVER_MAX_ATTEMPTS_BEFORE_LONG_PAUSE)
-        {
-            nextRecoverMs = now + RECOVER_LONG_PAUSE_MS;
-            recoverAttempts = 0;
-            return;
-        }
-
-        recoverAttempts++;
-        bool ok = oledRecoverNow();
-        if (ok)
-        {
-            oledFault = false;
-        }
-        else
-        {
-            nextRecoverMs = now + RECOVER_BACKOFF_MS;
-            return;
-        }
-    }
-
-    // 2) nothing to do or nothing to show
+    // 1) nothing to do or nothing to show
     if (!flushRequested)
         return;
     if (!dirty && overlayFn == nullptr)
         return;
 
-    // 3) limiter
+    // 2) limiter
     if (!flushForceRequested && (now - lastFlushMs) < MIN_FLUSH_INTERVAL_MS)
         return;
 
-    renderAll();
+    publishFrame();
 
     lastFlushMs = now;
     flushRequested = false;
     flushForceRequested = false;
 }
+
+DisplayStats displayGetStats()
+{
+    return statsOut.read();
+}
@@ -0,0 +1,29 @@
+#include <Arduino.h>
+#include "common/seqlock.h"
+#include "controller/input_snapshot.h"
+#include "controller/joysticks.h"
+
+// Written by the control task only; read by the UI core
+static Seqlock<InputSnapshot> gInput;
+
+uint32_t inputCapture()
+{
+    InputSnapshot s{};
+    s.atMs = millis();
+    s.atUs = joysticksReadRaw(s.raw);
+
+    // Filters advance once per capture, i.e. at the control tick rate
+    uint16_t filtered[INPUT_AXIS_COUNT];
+    for (uint8_t i = 0; i < INPUT_AXIS_COUNT; ++i)
+        filtered[i] = joysticksFilterRaw(i, s.raw[i]);
+    joysticksShape(filtered, s.raw, s.axis, s.linear);
+    s.keys = buttonsDownMask();
+
+    gInput.write(s);
+    return s.atUs;
+}
+
+InputSnapshot inputSnapshot()
+{
+    return gInput.read();
+}
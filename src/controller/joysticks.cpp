@@ -3,6 +3,8 @@
 #include <math.h>
 #include <string.h>
 #include "controller/joysticks.h"
+#include "controller/adc_sampler.h"
+#include "controller/control_task.h"
 #include "controller/config.h"
 
 Joystick joyL(JOY_L_PIN_X, JOY_L_PIN_Y, JOY_L_PIN_BTN);
@@ -50,10 +52,19 @@ struct LimitData
     uint16_t crc;
 };
 
+struct FilterData
+{
+    uint16_t magic;
+    uint8_t type[4];
+    uint8_t strength[4];
+    uint16_t crc;
+};
+
 static const uint16_t CAL_MAGIC = 0xCA11;
 static const uint16_t DEADZONE_MAGIC = 0xD00D;
 static const uint16_t EXPO_MAGIC = 0xE202;
 static const uint16_t LIMIT_MAGIC = 0x1A17;
+static const uint16_t FILTER_MAGIC = 0xF117;
 
 static uint16_t crcCal(const CalData &d)
 {
@@ -65,6 +76,27 @@ static const char *STORAGE_KEY_JOY_R = "joy_r_cal";
 static const char *STORAGE_KEY_DEADZONE = "joy_deadzone";
 static const char *STORAGE_KEY_EXPO = "joy_expo";
 static const char *STORAGE_KEY_LIMIT = "joy_limit";
+static const char *STORAGE_KEY_FILTER = "joy_filter";
+
+// Owned by the control task; the UI changes them under the control lock
+static InputFilter gFilter[4];
+static uint32_t gFilterRateHz = JOY_FILTER_RATE_DEFAULT_HZ;
+
+// Stick shaping, lane = axis index (0=lx,1=ly,2=rx,3=ry). The full curve
+// (invert -> calibration -> deadzone -> expo -> limit) is tabulated per
+// axis over every ADC value from the fixed-point shaper, so the control
+// path reads one table entry; the calibration-only view runs the shaper.
+// Double buffered: the control task reads gShape[gShapeFront]; the UI task
+// fills the other one and flips gShapeFront under the control lock.
+// 2 x 4 x 8 KB of tables.
+struct StickShape
+{
+    AxisBatch<4> curve;
+    AxisBatch<4, AXIS_FEAT_INVERT> linear;
+    int16_t lut[4][ADC_MAX + 1]; // Q15 (+-AXIS_OUT_MAX), indexed by physical ADC value
+};
+static StickShape gShape[2];
+static uint8_t gShapeFront = 0;
 
 static uint16_t crcDeadzone(const DeadzoneData &d)
 {
@@ -119,10 +151,16 @@ static uint16_t crcLimit(const LimitData &d)
     return (uint16_t)(d.magic ^ d.limLX ^ d.limLY ^ d.limRX ^ d.limRY ^ 0x6C17);
 }
 
-void joystickInit()
+static uint16_t crcFilter(const FilterData &d)
 {
-    analogReadResolution(ADC_BITS);
+    uint16_t crc = d.magic ^ 0x3C3C;
+    for (uint8_t i = 0; i < 4; ++i)
+        crc ^= (uint16_t)(((uint16_t)d.type[i] << 8) | d.strength[i]) << (i & 1);
+    return crc;
+}
 
+void joystickInit()
+{
     joyL.begin();
     joyR.begin();
 
@@ -169,6 +207,18 @@ void joystickInit()
         joyL.setLimitPct(clampLimitPct((int)lim.limLX), clampLimitPct((int)lim.limLY));
         joyR.setLimitPct(clampLimitPct((int)lim.limRX), clampLimitPct((int)lim.limRY));
     }
+
+    const InputFilterConfig filterDefault{(InputFilterType)JOY_FILTER_TYPE_DEFAULT, JOY_FILTER_STRENGTH_DEFAULT};
+    for (uint8_t i = 0; i < 4; ++i)
+        gFilter[i].configure(filterDefault, gFilterRateHz);
+
+    FilterData flt{};
+    if (storageReadBlob(STORAGE_KEY_FILTER, &flt, sizeof(flt)) &&
+        flt.magic == FILTER_MAGIC && flt.crc == crcFilter(flt))
+    {
+        for (uint8_t i = 0; i < 4; ++i)
+            gFilter[i].configure(InputFilterConfig{(InputFilterType)flt.type[i], flt.strength[i]}, gFilterRateHz);
+    }
 }
 
 Joystick::Joystick(uint8_t pinX, uint8_t pinY, uint8_t pinBtn)
@@ -181,7 +231,7 @@ void Joystick::begin()
 
 int Joystick::readAxisRaw(uint8_t pin) const
 {
-    return analogRead(pin);
+    return adcSamplerRaw(pin);
 }
 
 int Joystick::readRawX() const
@@ -209,6 +259,80 @@ int Joystick::applyInvert(int raw, bool isX) const
     return (isX ? invertX : invertY) ? (ADC_MAX - raw) : raw;
 }
 
+void Joystick::setInvertX(bool b)
+{
+    ControlLockGuard lock;
+    invertX = b;
+    shapeDirtyX = true;
+}
+
+void Joystick::setInvertY(bool b)
+{
+    ControlLockGuard lock;
+    invertY = b;
+    shapeDirtyY = true;
+}
+
+void Joystick::setDeadzone(int dzX, int dzY)
+{
+    ControlLockGuard lock;
+    deadzoneX = dzX;
+    deadzoneY = dzY;
+    invalidateShape();
+}
+
+void Joystick::setExpo(float e)
+{
+    ControlLockGuard lock;
+    expoX = e;
+    expoY = e;
+    invalidateShape();
+}
+
+void Joystick::setExpoX(float e)
+{
+    ControlLockGuard lock;
+    expoX = e;
+    shapeDirtyX = true;
+}
+
+void Joystick::setExpoY(float e)
+{
+    ControlLockGuard lock;
+    expoY = e;
+    shapeDirtyY = true;
+}
+
+void Joystick::setLimitPct(int pctX, int pctY)
+{
+    ControlLockGuard lock;
+    limitPctX = pctX;
+    limitPctY = pctY;
+    invalidateShape();
+}
+
+void Joystick::setLimitPctX(int pct)
+{
+    ControlLockGuard lock;
+    limitPctX = pct;
+    shapeDirtyX = true;
+}
+
+void Joystick::setLimitPctY(int pct)
+{
+    ControlLockGuard lock;
+    limitPctY = pct;
+    shapeDirtyY = true;
+}
+
+void Joystick::setCenter(int cx, int cy)
+{
+    ControlLockGuard lock;
+    centerX = cx;
+    centerY = cy;
+    invalidateShape();
+}
+
 // ------------------------------------
 //       KALIBRACJA
 // ------------------------------------
@@ -225,6 +349,7 @@ bool Joystick::loadCalibration(const char *key)
     if (d.maxX > ADC_MAX || d.maxY > ADC_MAX)
         return false;
 
+    ControlLockGuard lock; // not across the flash read above
     calMinX = d.minX;
     calMaxX = d.maxX;
     calMinY = d.minY;
@@ -239,6 +364,7 @@ bool Joystick::loadCalibration(const char *key)
         centerX = midX;
     if (centerY < calMinY || centerY > calMaxY)
         centerY = midY;
+    invalidateShape();
     return true;
 }
 
@@ -258,27 +384,43 @@ void Joystick::saveCalibration(const char *key)
 
 void Joystick::startCalibration()
 {
+    ControlLockGuard lock;
     calMinX = calMinY = ADC_MAX;
     calMaxX = calMaxY = 0;
+    invalidateShape();
 }
 
-void Joystick::updateCalibrationSample()
+void Joystick::updateCalibrationSample(int rawX, int rawY)
 {
-    int rx = applyInvert(readAxisRaw(pinX), true);
-    int ry = applyInvert(readAxisRaw(pinY), false);
+    ControlLockGuard lock;
+    int rx = applyInvert(rawX, true);
+    int ry = applyInvert(rawY, false);
 
     if (rx < calMinX)
+    {
         calMinX = rx;
+        shapeDirtyX = true;
+    }
     if (rx > calMaxX)
+    {
         calMaxX = rx;
+        shapeDirtyX = true;
+    }
     if (ry < calMinY)
+    {
         calMinY = ry;
+        shapeDirtyY = true;
+    }
     if (ry > calMaxY)
+    {
         calMaxY = ry;
+        shapeDirtyY = true;
+    }
 }
 
 void Joystick::finishCalibration()
 {
+    ControlLockGuard lock;
     // zabezpieczenie gdy nie ruszono drÄ…ĹĽkiem
     if (calMaxX <= calMinX + 2)
     {
@@ -293,10 +435,12 @@ void Joystick::finishCalibration()
 
     centerX = (calMinX + calMaxX) / 2;
     centerY = (calMinY + calMaxY) / 2;
+    invalidateShape();
 }
 
 void Joystick::setCalibration(int minX, int maxX, int minY, int maxY)
 {
+    ControlLockGuard lock;
     calMinX = (minX < 0) ? 0 : (minX > ADC_MAX ? ADC_MAX : minX);
     calMaxX = (maxX < 0) ? 0 : (maxX > ADC_MAX ? ADC_MAX : maxX);
     calMinY = (minY < 0) ? 0 : (minY > ADC_MAX ? ADC_MAX : minY);
@@ -315,6 +459,7 @@ void Joystick::setCalibration(int minX, int maxX, int minY, int maxY)
 
     centerX = (calMinX + calMaxX) / 2;
     centerY = (calMinY + calMaxY) / 2;
+    invalidateShape();
 }
 
 void joysticksLoadCalibration()
@@ -493,131 +638,178 @@ void joysticksSetLimitAxis(uint8_t axis, int pct)
     }
 }
 
-void joysticksSaveLimit()
+InputFilterConfig joysticksGetFilterAxis(uint8_t axis)
 {
-    LimitData d{};
-    d.magic = LIMIT_MAGIC;
-    d.limLX = (uint8_t)clampLimitPct(joyL.getLimitPctX());
-    d.limLY = (uint8_t)clampLimitPct(joyL.getLimitPctY());
-    d.limRX = (uint8_t)clampLimitPct(joyR.getLimitPctX());
-    d.limRY = (uint8_t)clampLimitPct(joyR.getLimitPctY());
-    d.crc = crcLimit(d);
-    storageWriteBlob(STORAGE_KEY_LIMIT, &d, sizeof(d));
+    if (axis >= 4)
+        return InputFilterConfig{InputFilterType::Off, 1};
+    return gFilter[axis].config();
 }
 
-float Joystick::processAxis(int raw, const char *axisName)
+void joysticksSetFilterAxis(uint8_t axis, const InputFilterConfig &cfg)
 {
-    raw = constrain(raw, 0, ADC_MAX);
-
-    bool isX = (axisName && axisName[0] == 'X');
-
-    raw = applyInvert(raw, isX);
+    if (axis >= 4)
+        return;
+    ControlLockGuard lock;
+    const InputFilterConfig cur = gFilter[axis].config();
+    if (cur.type == cfg.type && cur.strength == cfg.strength)
+        return;
+    gFilter[axis].configure(cfg, gFilterRateHz);
+}
 
-    int calMin = isX ? calMinX : calMinY;
-    int calMax = isX ? calMaxX : calMaxY;
-    int calCenter = isX ? centerX : centerY;
-    if (calMax <= calMin + 2)
+void joysticksSaveFilter()
+{
+    FilterData d{};
+    d.magic = FILTER_MAGIC;
+    for (uint8_t i = 0; i < 4; ++i)
     {
-        calMin = 0;
-        calMax = ADC_MAX;
-    } // fallback gdy brak kalibracji
-    if (calCenter < calMin || calCenter > calMax)
-        calCenter = (calMin + calMax) / 2;
+        const InputFilterConfig c = gFilter[i].config();
+        d.type[i] = (uint8_t)c.type;
+        d.strength[i] = c.strength;
+    }
+    d.crc = crcFilter(d);
+    storageWriteBlob(STORAGE_KEY_FILTER, &d, sizeof(d));
+}
 
-    int dz = isX ? deadzoneX : deadzoneY;
+uint32_t joysticksGetFilterDelayUs(uint8_t axis)
+{
+    return (axis < 4) ? gFilter[axis].groupDelayUs() : 0;
+}
 
-    float mid = (float)calCenter;
-    float spanPos = (float)(calMax - calCenter);
-    float spanNeg = (float)(calCenter - calMin);
-    if (spanPos < 1.0f)
-        spanPos = 1.0f;
-    if (spanNeg < 1.0f)
-        spanNeg = 1.0f;
+void joysticksSetFilterRate(uint32_t sampleRateHz)
+{
+    if (sampleRateHz == 0 || sampleRateHz == gFilterRateHz)
+        return;
+    gFilterRateHz = sampleRateHz;
+    for (uint8_t i = 0; i < 4; ++i)
+        gFilter[i].configure(gFilter[i].config(), gFilterRateHz);
+}
+
+uint16_t joysticksFilterRaw(uint8_t axis, uint16_t raw)
+{
+    return (axis < 4) ? gFilter[axis].update(raw) : raw;
+}
 
-    float centered = raw - mid;
-    float absC = fabs(centered);
-    float sign = (centered >= 0) ? 1.0f : -1.0f;
+static Joystick &axisStick(uint8_t axis)
+{
+    return (axis < 2) ? joyL : joyR;
+}
 
-    float xMax = (sign >= 0.0f) ? spanPos : spanNeg;
+uint32_t joysticksReadRaw(uint16_t *raw)
+{
+    static const uint8_t kAxisPins[4] = {JOY_L_PIN_X, JOY_L_PIN_Y, JOY_R_PIN_X, JOY_R_PIN_Y};
+    return adcSamplerReadRaw(kAxisPins, 4, raw);
+}
 
-    if (absC <= dz || xMax <= dz)
+void joysticksShapeTick()
+{
+    AxisParams p[4];
+    uint8_t changed = 0;
     {
-        return 0.0f;
+        ControlLockGuard lock; // one consistent parameter set
+        for (uint8_t axis = 0; axis < 4; ++axis)
+        {
+            Joystick &j = axisStick(axis);
+            const bool isX = (axis & 1) == 0;
+            if (!j.takeShapeDirty(isX))
+                continue;
+            p[axis] = j.shapeParams(isX);
+            changed = (uint8_t)(changed | (1u << axis));
+        }
+    }
+    if (!changed)
+        return;
+
+    // Unchanged lanes keep their curve; only the changed ones are re-tabulated
+    const uint8_t back = gShapeFront ^ 1;
+    StickShape &s = gShape[back];
+    s = gShape[gShapeFront];
+    for (uint8_t axis = 0; axis < 4; ++axis)
+    {
+        if (!(changed & (1u << axis)))
+            continue;
+        s.curve.setAxis(axis, p[axis]);
+        s.linear.setAxis(axis, p[axis]);
+        for (uint16_t raw = 0; raw <= ADC_MAX; ++raw)
+            s.lut[axis][raw] = s.curve.processOne(axis, raw);
     }
 
-    float x = absC;
-    float norm = (x - dz) / (xMax - dz);
-    if (norm < 0.0f)
-        norm = 0.0f;
-    if (norm > 1.0f)
-        norm = 1.0f;
-
-    float expoVal = isX ? expoX : expoY;
-    float curved = 100.0f * powf(norm, 1.0f + expoVal);
-    if (curved > 100.0f)
-        curved = 100.0f;
-
-    const float limitPct = (float)(isX ? limitPctX : limitPctY);
-    curved = curved * constrain(limitPct, 0.0f, 100.0f) / 100.0f;
+    ControlLockGuard lock; // the control task is between ticks
+    gShapeFront = back;
+}
 
-    return sign * curved;
+void joysticksShape(const uint16_t *filtered, const uint16_t *raw, int16_t *curveQ15, int16_t *linearQ15)
+{
+    const StickShape &s = gShape[gShapeFront];
+    for (uint8_t axis = 0; axis < 4; ++axis)
+        curveQ15[axis] = s.lut[axis][(filtered[axis] > ADC_MAX) ? ADC_MAX : filtered[axis]];
+    s.linear.process(raw, linearQ15);
 }
 
-float Joystick::processAxisLinear(int raw, const char *axisName) const
+float joysticksCurvePct(uint8_t axis, float xNorm)
 {
-    raw = constrain(raw, 0, ADC_MAX);
+    if (axis >= 4)
+        return 0.0f;
+    // The front shaper only changes on this task
+    joysticksShapeTick();
+    const int raw = axisStick(axis).curveRaw((axis & 1) == 0, xNorm);
+    return (float)gShape[gShapeFront].lut[axis][raw] * 100.0f / (float)AXIS_OUT_MAX;
+}
 
-    bool isX = (axisName && axisName[0] == 'X');
-    raw = applyInvert(raw, isX);
+void joysticksSaveLimit()
+{
+    LimitData d{};
+    d.magic = LIMIT_MAGIC;
+    d.limLX = (uint8_t)clampLimitPct(joyL.getLimitPctX());
+    d.limLY = (uint8_t)clampLimitPct(joyL.getLimitPctY());
+    d.limRX = (uint8_t)clampLimitPct(joyR.getLimitPctX());
+    d.limRY = (uint8_t)clampLimitPct(joyR.getLimitPctY());
+    d.crc = crcLimit(d);
+    storageWriteBlob(STORAGE_KEY_LIMIT, &d, sizeof(d));
+}
 
-    int calMin = isX ? calMinX : calMinY;
-    int calMax = isX ? calMaxX : calMaxY;
-    int calCenter = isX ? centerX : centerY;
+void Joystick::axisRange(bool isX, int &calMin, int &calMax, int &calCenter) const
+{
+    calMin = isX ? calMinX : calMinY;
+    calMax = isX ? calMaxX : calMaxY;
+    calCenter = isX ? centerX : centerY;
     if (calMax <= calMin + 2)
     {
         calMin = 0;
         calMax = ADC_MAX;
-    }
+    } // fallback gdy brak kalibracji
     if (calCenter < calMin || calCenter > calMax)
         calCenter = (calMin + calMax) / 2;
-
-    float spanPos = (float)(calMax - calCenter);
-    float spanNeg = (float)(calCenter - calMin);
-    if (spanPos < 1.0f)
-        spanPos = 1.0f;
-    if (spanNeg < 1.0f)
-        spanNeg = 1.0f;
-
-    float centered = (float)raw - (float)calCenter;
-    float sign = (centered >= 0.0f) ? 1.0f : -1.0f;
-    float span = (sign >= 0.0f) ? spanPos : spanNeg;
-    float norm = fabsf(centered) / span;
-    if (norm > 1.0f)
-        norm = 1.0f;
-
-    return sign * norm * 100.0f;
 }
 
-float Joystick::readX()
+AxisParams Joystick::shapeParams(bool isX) const
 {
-    int raw = readAxisRaw(pinX);
-    return processAxis(raw, "X");
+    AxisParams p{};
+    p.adcMax = ADC_MAX;
+    p.calMin = (uint16_t)(isX ? calMinX : calMinY);
+    p.calMax = (uint16_t)(isX ? calMaxX : calMaxY);
+    p.calCenter = (uint16_t)(isX ? centerX : centerY);
+    p.deadzone = (uint16_t)constrain(isX ? deadzoneX : deadzoneY, 0, ADC_MAX);
+    p.expo = isX ? expoX : expoY;
+    p.limitPct = (uint8_t)constrain(isX ? limitPctX : limitPctY, 0, 100);
+    p.invert = isX ? invertX : invertY;
+    return p;
 }
 
-float Joystick::readY()
+bool Joystick::takeShapeDirty(bool isX)
 {
-    int raw = readAxisRaw(pinY);
-    return processAxis(raw, "Y");
+    bool &dirty = isX ? shapeDirtyX : shapeDirtyY;
+    const bool was = dirty;
+    dirty = false;
+    return was;
 }
 
-float Joystick::readLinearX()
+int Joystick::curveRaw(bool isX, float xNorm) const
 {
-    int raw = readAxisRaw(pinX);
-    return processAxisLinear(raw, "X");
-}
+    int calMin, calMax, calCenter;
+    axisRange(isX, calMin, calMax, calCenter);
 
-float Joystick::readLinearY()
-{
-    int raw = readAxisRaw(pinY);
-    return processAxisLinear(raw, "Y");
+    xNorm = constrain(xNorm, 0.0f, 1.0f);
+    int raw = calCenter + (int)lroundf(xNorm * (float)(calMax - calCenter));
+    // inversion is its own inverse: control orientation -> physical ADC index
+    return applyInvert(constrain(raw, 0, ADC_MAX), isX);
 }
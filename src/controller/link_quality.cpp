@@ -0,0 +1,266 @@
+#include <Arduino.h>
+#include "common/spsc_queue.h"
+#include "controller/link_quality.h"
+
+// ==================== Debug ====================
+#define LINK_QUALITY_SERIAL 1 // 1 = export each closed window to Serial (USB), 0 = off
+
+static const uint32_t WINDOW_MS = 1000;
+
+// Radio side -> UI side. Producers hold the control lock; the UI drains
+// the queue in linkQualityTick(), so aggregation and the Serial export
+// stay off the control core. Sized for ~250 ms of UI stall at 500 Hz.
+enum class LqEventType : uint8_t
+{
+    Reset,
+    Tx,
+    Send
+};
+
+struct LqEvent
+{
+    LqEventType type;
+    bool acked;
+    bool carrier;
+    bool ackPayload;
+    uint8_t retries;
+    uint8_t rxFrames;
+    uint8_t ackSeq;
+    uint16_t ackPrevWaitUs;
+    uint32_t a; // Tx: rttUs, Send: sampleAgeUs
+    uint32_t b; // Send: tickLatencyUs
+};
+
+static SpscQueue<LqEvent, 256> events;
+
+// Accumulators of the open window
+struct Window
+{
+    uint16_t sent;
+    uint16_t acked;
+    uint16_t rxFrames;
+    uint16_t carrier;
+    uint32_t retriesSum;
+    uint8_t retriesMax;
+    uint32_t rttSum;
+    uint32_t rttMax;
+    uint32_t tlmAgeSum;
+    uint16_t tlmAgeCount;
+    uint32_t tlmAgeMax;
+    uint16_t tlmMissed;
+    uint32_t sampleAgeSum;
+    uint32_t sampleAgeMax;
+    uint16_t sendCount;
+    uint32_t tickLatencySum;
+    uint32_t tickLatencyMin;
+    uint32_t tickLatencyMax;
+};
+
+static Window win{};
+static LinkQualityStats stats{};
+static uint32_t windowStartMs = 0;
+static bool haveRxFrames = false;
+static uint8_t lastRxFrames = 0;
+static uint8_t lastAckSeq = 0;
+static uint32_t lastAckRttUs = 0;
+
+static uint16_t clampU16(uint32_t v)
+{
+    return (v > 0xFFFFUL) ? 0xFFFFU : (uint16_t)v;
+}
+
+static void closeWindow()
+{
+    LinkQualityStats s{};
+    s.valid = true;
+    s.txPerSec = win.sent;
+    s.ackPerSec = win.acked;
+    s.rxPerSec = win.rxFrames;
+    s.lqPct = (win.sent == 0) ? 0 : (uint8_t)(((uint32_t)win.acked * 100UL + win.sent / 2U) / win.sent);
+    s.retriesMax = win.retriesMax;
+    s.retriesAvgX10 = (win.sent == 0) ? 0 : (uint8_t)((win.retriesSum * 10UL + win.sent / 2U) / win.sent);
+    s.carrierPct = (win.acked == 0) ? 0 : (uint8_t)(((uint32_t)win.carrier * 100UL + win.acked / 2U) / win.acked);
+    s.rttAvgUs = (win.acked == 0) ? 0 : clampU16(win.rttSum / win.acked);
+    s.rttMaxUs = clampU16(win.rttMax);
+    s.tlmAgeAvgUs = (win.tlmAgeCount == 0) ? 0 : clampU16(win.tlmAgeSum / win.tlmAgeCount);
+    s.tlmAgeMaxUs = clampU16(win.tlmAgeMax);
+    s.tlmMissed = win.tlmMissed;
+    s.sampleAgeAvgUs = (win.sendCount == 0) ? 0 : clampU16(win.sampleAgeSum / win.sendCount);
+    s.sampleAgeMaxUs = clampU16(win.sampleAgeMax);
+    s.tickLatencyAvgUs = (win.sendCount == 0) ? 0 : clampU16(win.tickLatencySum / win.sendCount);
+    s.tickJitterUs = (win.sendCount == 0) ? 0 : clampU16(win.tickLatencyMax - win.tickLatencyMin);
+    stats = s;
+    win = Window{};
+
+#if LINK_QUALITY_SERIAL
+    Serial.print("[LQ] lq=");
+    Serial.print(s.lqPct);
+    Serial.print(" tx=");
+    Serial.print(s.txPerSec);
+    Serial.print(" ack=");
+    Serial.print(s.ackPerSec);
+    Serial.print(" rx=");
+    Serial.print(s.rxPerSec);
+    Serial.print(" arc=");
+    Serial.print(s.retriesAvgX10 / 10);
+    Serial.print(".");
+    Serial.print(s.retriesAvgX10 % 10);
+    Serial.print("/");
+    Serial.print(s.retriesMax);
+    Serial.print(" rpd=");
+    Serial.print(s.carrierPct);
+    Serial.print(" rtt=");
+    Serial.print(s.rttAvgUs);
+    Serial.print("/");
+    Serial.print(s.rttMaxUs);
+    Serial.print(" tlm=");
+    Serial.print(s.tlmAgeAvgUs);
+    Serial.print("/");
+    Serial.print(s.tlmAgeMaxUs);
+    Serial.print(" miss=");
+    Serial.print(s.tlmMissed);
+    Serial.print(" age=");
+    Serial.print(s.sampleAgeAvgUs);
+    Serial.print("/");
+    Serial.print(s.sampleAgeMaxUs);
+    Serial.print(" tick=");
+    Serial.print(s.tickLatencyAvgUs);
+    Serial.print("~");
+    Serial.println(s.tickJitterUs);
+#endif
+}
+
+static void applyReset()
+{
+    win = Window{};
+    stats = LinkQualityStats{};
+    windowStartMs = millis();
+    haveRxFrames = false;
+    lastRxFrames = 0;
+    lastAckSeq = 0;
+    lastAckRttUs = 0;
+}
+
+static void applyTx(const LqEvent &info)
+{
+    win.sent++;
+    win.retriesSum += info.retries;
+    if (info.retries > win.retriesMax)
+        win.retriesMax = info.retries;
+
+    if (!info.acked)
+        return;
+
+    win.acked++;
+    if (info.carrier)
+        win.carrier++;
+    win.rttSum += info.a;
+    if (info.a > win.rttMax)
+        win.rttMax = info.a;
+
+    // Receiver counter wraps at 256; sum deltas between consecutive ACKs
+    if (info.ackPayload)
+    {
+        if (haveRxFrames)
+        {
+            win.rxFrames += (uint8_t)(info.rxFrames - lastRxFrames);
+
+            // prevWait describes the payload we got last time: its age on arrival
+            // was the FIFO wait plus (at most) that frame's round trip
+            const uint8_t seqDelta = (uint8_t)(info.ackSeq - lastAckSeq);
+            if (seqDelta == 1 && info.ackPrevWaitUs != 0xFFFFU)
+            {
+                const uint32_t age = info.ackPrevWaitUs + lastAckRttUs;
+                win.tlmAgeSum += age;
+                win.tlmAgeCount++;
+                if (age > win.tlmAgeMax)
+                    win.tlmAgeMax = age;
+            }
+            else if (seqDelta > 1)
+            {
+                win.tlmMissed += (uint16_t)(seqDelta - 1u);
+            }
+        }
+        lastRxFrames = info.rxFrames;
+        lastAckSeq = info.ackSeq;
+        lastAckRttUs = info.a;
+        haveRxFrames = true;
+    }
+}
+
+static void applySend(uint32_t sampleAgeUs, uint32_t tickLatencyUs)
+{
+    win.sampleAgeSum += sampleAgeUs;
+    if (sampleAgeUs > win.sampleAgeMax)
+        win.sampleAgeMax = sampleAgeUs;
+    win.tickLatencySum += tickLatencyUs;
+    if (win.sendCount == 0 || tickLatencyUs < win.tickLatencyMin)
+        win.tickLatencyMin = tickLatencyUs;
+    if (tickLatencyUs > win.tickLatencyMax)
+        win.tickLatencyMax = tickLatencyUs;
+    win.sendCount++;
+}
+
+void linkQualityReset()
+{
+    LqEvent e{};
+    e.type = LqEventType::Reset;
+    events.push(e);
+}
+
+void linkQualityOnTx(CommTxStatus status, const CommTxInfo &info)
+{
+    if (status != CommTxStatus::Acked && status != CommTxStatus::Failed)
+        return;
+
+    LqEvent e{};
+    e.type = LqEventType::Tx;
+    e.acked = (status == CommTxStatus::Acked);
+    e.carrier = info.carrier;
+    e.ackPayload = info.ackPayload;
+    e.retries = info.retries;
+    e.rxFrames = info.rxFrames;
+    e.ackSeq = info.ackSeq;
+    e.ackPrevWaitUs = info.ackPrevWaitUs;
+    e.a = info.rttUs;
+    events.push(e);
+}
+
+void linkQualityOnSend(uint32_t sampleAgeUs, uint32_t tickLatencyUs)
+{
+    LqEvent e{};
+    e.type = LqEventType::Send;
+    e.a = sampleAgeUs;
+    e.b = tickLatencyUs;
+    events.push(e);
+}
+
+void linkQualityTick(uint32_t nowMs)
+{
+    LqEvent e;
+    while (events.pop(e))
+    {
+        switch (e.type)
+        {
+        case LqEventType::Reset:
+            applyReset();
+            break;
+        case LqEventType::Tx:
+            applyTx(e);
+            break;
+        case LqEventType::Send:
+            applySend(e.a, e.b);
+            break;
+        }
+    }
+
+    if (nowMs - windowStartMs < WINDOW_MS)
+        return;
+    windowStartMs = nowMs;
+    closeWindow();
+}
+
+LinkQualityStats linkQualityGet()
+{
+    return stats;
+}
@@ -1,24 +1,32 @@
 #include "ide_compat.h"
 #include <Arduino.h>
 #include <Wire.h>
-#include "common/comm.h"
-#include "common/time_utils.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
 #include "controller/config.h"
+#include "common/comm.h"
+#include "common/scheduler.h"
 #include "controller/display.h"
 #include "controller/buttons.h"
 #include "controller/leds.h"
 #include "controller/control_link.h"
+#include "controller/control_task.h"
+#include "controller/adc_sampler.h"
 #include "controller/joysticks.h"
+#include "controller/mixer.h"
 #include "controller/photo_sensor.h"
 #include "controller/storage.h"
 #include "controller/battery.h"
-#include "controller/tx_frame.h"
 #include "controller/ui/menu.h"
 #include "controller/receiver.h"
+#include "controller/models.h"
+#include "controller/link_quality.h"
 
 int mode = 0;
 static uint8_t batState = 0;
 
+static void uiTaskStart();
+
 void setup()
 {
     Serial.begin(115200);
@@ -30,6 +38,7 @@ void setup()
     displayInit();
     buttonsInit();
     ledsInit();
+    adcSamplerInit();
     joystickInit();
     photoSensorInit();
     batteryInit();
@@ -57,12 +66,14 @@ void setup()
     ledsSet(LedSlot::Third, RED, 100);
     ledsShow();
 
-    static const uint8_t NRF_ADDR[5] = {'R', 'C', '0', '0', '1'};
-    const bool radioReady = commInit(NRF_CE_PIN, NRF_CSN_PIN, NRF_CHANNEL, NRF_ADDR);
+    const bool radioReady = commInit(NRF_CE_PIN, NRF_CSN_PIN, NRF_CHANNEL, NRF_ADDR_DEFAULT);
     receiverInit(radioReady);
+    modelsInit();
 
     menuInit();
     controlLinkInit();
+    joysticksShapeTick(); // stick curves in place before the first control tick
+    controlTaskStart();
 
     displayClear();
     displayText(0, "BOOT OK");
@@ -75,36 +86,96 @@ void setup()
     {
         Serial.println("[RADIO] init failed");
     }
-}
 
-void loop()
-{
-    buttonsTick();
-    batteryTick();
+    // Last: from here on only the UI task touches UI state
+    uiTaskStart();
+}
 
-#if PERF_DEBUG
-    uint32_t t0 = millis();
-#endif
+// ===== UI task: cooperative schedule (common/scheduler.h) =====
+// Everything except the control tick (control_task.h)
 
+static void uiTick()
+{
     bool inCalib = menuLoop(mode, batState);
+    joysticksShapeTick(); // curve edits / calibration from the menu
     const bool inMainLoop = menuIsInMainLoop();
     controlLinkTick(inMainLoop);
-    receiverLoop(txFrameBuild(!inCalib && controlLinkAllowsLiveControls(inMainLoop)));
+    controlSetLiveControls(!inCalib && controlLinkAllowsLiveControls(inMainLoop));
+    modelsTick();
+    mixerDebugTick();
+    displayTick();
+}
 
-    static uint32_t ledShowTick = 0;
-    if (everyMs(20, ledShowTick))
-    {
-        ledsShow();
-    }
+static void ledsTick()
+{
+    receiverLedTick();
+    ledsShow();
+}
 
-    displayTick();
+static void linkQualityDrain()
+{
+    linkQualityTick(millis());
+}
 
 #if PERF_DEBUG
-    uint32_t t1 = millis();
-    if (t1 - t0 > 20)
+static void schedReport()
+{
+    for (uint8_t i = 0; i < schedCount(); ++i)
+    {
+        SchedStats st{};
+        schedGetStats((int8_t)i, st);
+        Serial.print("[SCHED] ");
+        Serial.print(st.name);
+        Serial.print(" runs=");
+        Serial.print(st.runs);
+        Serial.print(" exec=");
+        Serial.print(st.execAvgUs);
+        Serial.print("/");
+        Serial.print(st.execMaxUs);
+        Serial.print("us jit=");
+        Serial.print(st.jitterAvgUs);
+        Serial.print("/");
+        Serial.print(st.jitterMaxUs);
+        Serial.print("us miss=");
+        Serial.print(st.missed);
+        Serial.print(" skip=");
+        Serial.println(st.skipped);
+    }
+    schedResetStats();
+}
+#endif
+
+static void uiTaskMain(void *)
+{
+    for (;;)
     {
-        Serial.print("[SLOW] loop ms=");
-        Serial.println(t1 - t0);
+        // Always block at least one tick: the core 0 idle task feeds the watchdog
+        const uint32_t waitUs = schedRun();
+        const TickType_t ticks = pdMS_TO_TICKS(waitUs / 1000UL);
+        vTaskDelay(ticks > 0 ? ticks : 1);
     }
+}
+
+// Priority: input first, then the UI pass, LEDs and bookkeeping.
+// Phases spread the periodic work across the 1 ms ticks.
+static void uiTaskStart()
+{
+    schedAdd("buttons", buttonsTick, BUTTONS_SAMPLE_MS * 1000UL, 0, 4);
+    schedAdd("ui", uiTick, UI_TICK_MS * 1000UL, 500, 3);
+    schedAdd("leds", ledsTick, LEDS_TICK_MS * 1000UL, 2000, 2);
+    schedAdd("lq", linkQualityDrain, LINK_QUALITY_TICK_MS * 1000UL, 3000, 1);
+    schedAdd("battery", batteryTick, BATTERY_READ_INTERVAL_MS * 1000UL, 4000, 1);
+#if PERF_DEBUG
+    schedAdd("report", schedReport, SCHED_REPORT_MS * 1000UL, SCHED_REPORT_MS * 1000UL, 0);
 #endif
+
+    xTaskCreatePinnedToCore(uiTaskMain, "ui", UI_TASK_STACK, nullptr,
+                            UI_TASK_PRIORITY, nullptr, UI_TASK_CORE);
+}
+
+void loop()
+{
+    // The UI runs in its own task on UI_TASK_CORE; leave the control core
+    // to the control task.
+    vTaskDelete(nullptr);
 }
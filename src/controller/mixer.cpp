@@ -0,0 +1,317 @@
+#include <Arduino.h>
+#include "common/seqlock.h"
+#include "controller/mixer.h"
+#include "controller/config.h"
+#include "controller/control_task.h"
+#include "controller/storage.h"
+
+// ==================== Debug ====================
+#define MIXER_DEBUG 0 // 1 = print evaluation time to Serial (USB), 0 = off
+#define MIXER_DEBUG_INTERVAL_MS 5000
+
+struct MixerData
+{
+    uint16_t magic;
+    MixerConfig cfg;
+    uint16_t crc;
+};
+
+static const uint16_t MIXER_MAGIC = 0x3A01;
+static const char *STORAGE_KEY_MIXER = "mix_cfg";
+
+// Source vector slots (MixSource order)
+#define MIX_SRC_COUNT ((uint8_t)MixSource::Count)
+#define MIX_Q15_MAX 32767
+
+// One compiled line. Curves become an optional abs() plus a clamp range,
+// conditions a key mask compare, Replace a mask that drops the old sum.
+struct MixInstr
+{
+    uint8_t src;
+    uint8_t dst;
+    uint16_t condMask; // key bits compared (1 << Key)
+    uint16_t condWant;
+    int16_t lo; // curve clamp, Q15
+    int16_t hi;
+    int16_t weight; // Q15
+    int16_t offset; // Q15
+    int8_t absMask;     // -1: abs() the source
+    int8_t replaceMask; // -1: Replace
+};
+
+static MixerConfig gCfg{};
+static uint8_t gModelId = 0;
+
+static MixInstr gProg[MIX_LINES_MAX];
+static uint8_t gProgCount = 0;
+static int16_t gTrimQ15[4] = {};
+static int16_t gSubtrimQ15[COMM_MAX_CHANNELS] = {};
+
+static MixerStats gStats{};
+static Seqlock<MixerStats> gStatsOut; // writers hold the control lock
+static uint32_t gEvalCycles = 0;
+static uint32_t gEvalCyclesMax = 0;
+static uint32_t gEvalCount = 0;
+static uint32_t gStatsMs = 0;
+
+static uint16_t crcMixer(const MixerData &d)
+{
+    const uint8_t *p = (const uint8_t *)&d.cfg;
+    uint16_t crc = (uint16_t)(d.magic ^ 0x3AA3);
+    for (size_t i = 0; i < sizeof(d.cfg); ++i)
+        crc = (uint16_t)(((crc << 1) | (crc >> 15)) ^ p[i]);
+    return crc;
+}
+
+static void modelKey(char *dst, size_t size, const char *base, uint8_t modelId)
+{
+    if (modelId == 0)
+        snprintf(dst, size, "%s", base);
+    else
+        snprintf(dst, size, "%s%u", base, (unsigned)modelId);
+}
+
+static int16_t pctToQ15(int pct)
+{
+    if (pct > 100)
+        pct = 100;
+    if (pct < -100)
+        pct = -100;
+    return (int16_t)((pct * MIX_Q15_MAX + ((pct >= 0) ? 50 : -50)) / 100);
+}
+
+static int8_t clampPct(int v, int limit)
+{
+    return (int8_t)constrain(v, -limit, limit);
+}
+
+static void sanitize(MixerConfig &cfg)
+{
+    if (cfg.channelCount == 0 || cfg.channelCount > COMM_MAX_CHANNELS)
+        cfg.channelCount = COMM_CH_DEFAULT_COUNT;
+    for (uint8_t i = 0; i < 4; ++i)
+        cfg.trim[i] = clampPct(cfg.trim[i], MIX_TRIM_MAX);
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+        cfg.subtrim[i] = clampPct(cfg.subtrim[i], 100);
+    for (uint8_t i = 0; i < MIX_LINES_MAX; ++i)
+    {
+        MixLine &l = cfg.line[i];
+        if (l.output >= COMM_MAX_CHANNELS || (uint8_t)l.source >= (uint8_t)MixSource::Count)
+            l.source = MixSource::None;
+        if ((uint8_t)l.curve >= (uint8_t)MixCurve::Count)
+            l.curve = MixCurve::Linear;
+        if ((uint8_t)l.condition >= (uint8_t)MixCondition::Count)
+            l.condition = MixCondition::Always;
+        if ((uint8_t)l.op >= (uint8_t)MixOp::Count)
+            l.op = MixOp::Add;
+        l.weight = clampPct(l.weight, 100);
+        l.offset = clampPct(l.offset, 100);
+        l.reserved = 0;
+    }
+}
+
+static void compileCondition(MixCondition c, uint16_t &mask, uint16_t &want)
+{
+    static const Key kKeys[4] = {Key::JL, Key::JR, Key::F1, Key::F2};
+    mask = 0;
+    want = 0;
+    if (c == MixCondition::Always)
+        return;
+
+    // JlOn, JlOff, JrOn, ... : key = (c - 1) / 2, odd values = held
+    const uint8_t idx = (uint8_t)c - 1;
+    mask = (uint16_t)(1u << (uint8_t)kKeys[idx / 2]);
+    want = (idx % 2 == 0) ? mask : 0;
+}
+
+static void compile()
+{
+    gProgCount = 0;
+    for (uint8_t i = 0; i < MIX_LINES_MAX; ++i)
+    {
+        const MixLine &l = gCfg.line[i];
+        if (l.source == MixSource::None)
+            continue;
+
+        MixInstr &op = gProg[gProgCount++];
+        op.src = (uint8_t)l.source;
+        op.dst = l.output;
+        compileCondition(l.condition, op.condMask, op.condWant);
+        op.lo = (l.curve == MixCurve::Positive || l.curve == MixCurve::Absolute) ? 0 : -MIX_Q15_MAX;
+        op.hi = (l.curve == MixCurve::Negative) ? 0 : MIX_Q15_MAX;
+        op.absMask = (l.curve == MixCurve::Absolute) ? -1 : 0;
+        op.replaceMask = (l.op == MixOp::Replace) ? -1 : 0;
+        op.weight = pctToQ15(l.weight);
+        op.offset = pctToQ15(l.offset);
+    }
+
+    for (uint8_t i = 0; i < 4; ++i)
+        gTrimQ15[i] = pctToQ15(gCfg.trim[i]);
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+        gSubtrimQ15[i] = pctToQ15(gCfg.subtrim[i]);
+
+    gStats.opCount = gProgCount;
+    gStatsOut.write(gStats);
+}
+
+void mixerDefaults(MixerConfig &cfg)
+{
+    cfg = MixerConfig{};
+    cfg.channelCount = COMM_CH_DEFAULT_COUNT;
+
+    static const MixSource kDirect[COMM_CH_DEFAULT_COUNT] = {
+        MixSource::LX, MixSource::LY, MixSource::RX, MixSource::RY,
+        MixSource::JL, MixSource::JR, MixSource::F1, MixSource::F2};
+    for (uint8_t i = 0; i < COMM_CH_DEFAULT_COUNT; ++i)
+    {
+        MixLine &l = cfg.line[i];
+        l.output = i;
+        l.source = kDirect[i];
+        l.weight = 100;
+    }
+}
+
+void mixerLoadModel(uint8_t modelId)
+{
+    MixerConfig cfg{};
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_MIXER, modelId);
+    MixerData d{};
+    if (storageReadBlob(key, &d, sizeof(d)) &&
+        d.magic == MIXER_MAGIC && d.crc == crcMixer(d))
+    {
+        cfg = d.cfg;
+    }
+    else
+    {
+        mixerDefaults(cfg);
+    }
+
+    ControlLockGuard lock;
+    gModelId = modelId;
+    mixerSetConfig(cfg);
+}
+
+void mixerSaveModel()
+{
+    MixerData d{};
+    d.magic = MIXER_MAGIC;
+    d.cfg = gCfg;
+    d.crc = crcMixer(d);
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_MIXER, gModelId);
+    storageWriteBlob(key, &d, sizeof(d));
+}
+
+const MixerConfig &mixerGetConfig()
+{
+    return gCfg;
+}
+
+void mixerSetConfig(const MixerConfig &cfg)
+{
+    ControlLockGuard lock;
+    gCfg = cfg;
+    sanitize(gCfg);
+    compile();
+}
+
+static void updateStats(uint32_t cycles)
+{
+    gEvalCycles += cycles;
+    if (cycles > gEvalCyclesMax)
+        gEvalCyclesMax = cycles;
+    ++gEvalCount;
+
+    const uint32_t now = millis();
+    if (now - gStatsMs < MIXER_DEBUG_INTERVAL_MS)
+        return;
+    gStatsMs = now;
+
+    const uint32_t mhz = ESP.getCpuFreqMHz();
+    gStats.evalAvgNs = (uint32_t)((uint64_t)gEvalCycles * 1000u / ((uint64_t)gEvalCount * mhz));
+    gStats.evalMaxNs = gEvalCyclesMax * 1000u / mhz;
+    gEvalCycles = 0;
+    gEvalCyclesMax = 0;
+    gEvalCount = 0;
+    gStats.windows++;
+    gStatsOut.write(gStats);
+}
+
+// Snapshot axes are already Q15 on the mixer scale (AXIS_OUT_MAX == MIX_Q15_MAX)
+static int32_t axisToQ15(int16_t q, int16_t trim)
+{
+    const int32_t v = (int32_t)q + trim;
+    return constrain(v, -MIX_Q15_MAX, MIX_Q15_MAX);
+}
+
+static int32_t keyToQ15(const InputSnapshot &in, Key k)
+{
+    return inputKeyDown(in, k) ? MIX_Q15_MAX : -MIX_Q15_MAX;
+}
+
+void mixerEvaluate(const InputSnapshot &in, CommFrame &out)
+{
+    const uint32_t startCycles = ESP.getCycleCount();
+
+    int32_t src[MIX_SRC_COUNT];
+    src[(uint8_t)MixSource::None] = 0;
+    for (uint8_t i = 0; i < 4; ++i)
+        src[(uint8_t)MixSource::LX + i] = axisToQ15(in.axis[i], gTrimQ15[i]);
+    src[(uint8_t)MixSource::JL] = keyToQ15(in, Key::JL);
+    src[(uint8_t)MixSource::JR] = keyToQ15(in, Key::JR);
+    src[(uint8_t)MixSource::F1] = keyToQ15(in, Key::F1);
+    src[(uint8_t)MixSource::F2] = keyToQ15(in, Key::F2);
+    src[(uint8_t)MixSource::Max] = MIX_Q15_MAX;
+
+    int32_t acc[COMM_MAX_CHANNELS] = {};
+    const uint16_t keys = in.keys;
+    for (uint8_t i = 0; i < gProgCount; ++i)
+    {
+        const MixInstr &op = gProg[i];
+        int32_t v = src[op.src];
+        const int32_t sign = (v >> 31) & op.absMask;
+        v = (v ^ sign) - sign;
+        v = (v < op.lo) ? op.lo : v;
+        v = (v > op.hi) ? op.hi : v;
+
+        const int32_t r = ((v * op.weight) >> 15) + op.offset;
+        const int32_t on = -(int32_t)((keys & op.condMask) == op.condWant); // -1 or 0
+        const int32_t keep = ~(on & op.replaceMask);
+        acc[op.dst] = (acc[op.dst] & keep) + (r & on);
+    }
+
+    out.channelCount = gCfg.channelCount;
+    for (uint8_t ch = 0; ch < COMM_MAX_CHANNELS; ++ch)
+    {
+        int32_t v = acc[ch] + gSubtrimQ15[ch];
+        v = constrain(v, -MIX_Q15_MAX, MIX_Q15_MAX);
+        out.ch[ch] = (uint16_t)(COMM_CH_CENTER + ((v * COMM_CH_SPAN + (1L << 14)) >> 15));
+    }
+
+    updateStats(ESP.getCycleCount() - startCycles);
+}
+
+MixerStats mixerGetStats()
+{
+    return gStatsOut.read();
+}
+
+void mixerDebugTick()
+{
+#if MIXER_DEBUG
+    static uint32_t printed = 0;
+    const MixerStats s = gStatsOut.read();
+    if (s.windows == printed)
+        return;
+    printed = s.windows;
+
+    Serial.print("[MIX] ops=");
+    Serial.print(s.opCount);
+    Serial.print(" eval avg=");
+    Serial.print(s.evalAvgNs);
+    Serial.print("ns max=");
+    Serial.print(s.evalMaxNs);
+    Serial.println("ns");
+#endif
+}
@@ -0,0 +1,401 @@
+#include <Arduino.h>
+#include "controller/config.h"
+#include "common/comm.h"
+#include "controller/models.h"
+#include "controller/control_task.h"
+#include "controller/mixer.h"
+#include "controller/receiver.h"
+#include "controller/storage.h"
+
+// ==================== Debug ====================
+#define MODELS_DEBUG 0 // 1 = print bind / model changes to Serial (USB), 0 = off
+
+struct ModelData
+{
+    uint16_t magic;
+    uint8_t bound;
+    uint8_t address[5];
+    uint16_t crc;
+};
+
+struct ActiveModelData
+{
+    uint16_t magic;
+    uint8_t modelId;
+    uint8_t reserved;
+    uint16_t crc;
+};
+
+// Models driven together in time slots (bit per model id)
+struct GroupData
+{
+    uint16_t magic;
+    uint8_t mask;
+    uint8_t reserved;
+    uint16_t crc;
+};
+
+static const uint16_t MODEL_MAGIC = 0x3D01;
+static const uint16_t ACTIVE_MAGIC = 0x3D02;
+static const uint16_t GROUP_MAGIC = 0x3D03;
+static const char *STORAGE_KEY_ACTIVE = "model_act";
+static const char *STORAGE_KEY_GROUP = "rx_group";
+
+static ModelData gModels[MODEL_COUNT] = {};
+static uint8_t gActive = 0;  // persisted choice
+static uint8_t gCurrent = 0; // on air right now (differs while scanning)
+static uint8_t gGroupMask = 0;
+static uint32_t lastScanMs = 0;
+
+static ModelBindState gBindState = ModelBindState::Idle;
+static uint8_t gBindModel = 0;
+static uint8_t gBindAddr[5] = {0};
+static uint32_t bindStartMs = 0;
+static uint32_t lastOfferMs = 0;
+static bool linkWasEnabled = false;
+
+static uint16_t crcModel(const ModelData &d)
+{
+    uint16_t crc = (uint16_t)(d.magic ^ d.bound ^ 0x4D31);
+    for (uint8_t i = 0; i < 5; ++i)
+        crc = (uint16_t)(((crc << 1) | (crc >> 15)) ^ d.address[i]);
+    return crc;
+}
+
+static uint16_t crcActive(const ActiveModelData &d)
+{
+    return (uint16_t)(d.magic ^ d.modelId ^ d.reserved ^ 0x4D32);
+}
+
+static uint16_t crcGroup(const GroupData &d)
+{
+    return (uint16_t)(d.magic ^ d.mask ^ d.reserved ^ 0x4D33);
+}
+
+static void modelKey(char *dst, size_t size, uint8_t modelId)
+{
+    snprintf(dst, size, "model%u", (unsigned)modelId);
+}
+
+/*
+ * Pair address: bytes 1..4 are FNV-1a over the chip MAC and shared by
+ * all models, so their receivers follow one hop sequence (time slots).
+ * Byte 0 tells the models apart; the values used are never 0x00 / 0x55 /
+ * 0xAA / 0xFF, which look like preamble or idle noise to the nRF24
+ * address matcher.
+ */
+static void deriveAddress(uint8_t modelId, uint8_t address[5])
+{
+    const uint64_t mac = ESP.getEfuseMac();
+    uint32_t h = 2166136261UL;
+    for (uint8_t i = 0; i < 6; ++i)
+    {
+        h ^= (uint8_t)(mac >> (8u * i));
+        h *= 16777619UL;
+    }
+
+    for (uint8_t i = 0; i < 4; ++i)
+        address[1 + i] = (uint8_t)(h >> (8u * i));
+
+    address[0] = (uint8_t)(0x10u + 0x11u * modelId); // 0x10, 0x21 .. 0x87
+}
+
+static void saveGroup()
+{
+    GroupData d{};
+    d.magic = GROUP_MAGIC;
+    d.mask = gGroupMask;
+    d.reserved = 0;
+    d.crc = crcGroup(d);
+    storageWriteBlob(STORAGE_KEY_GROUP, &d, sizeof(d));
+}
+
+// Bound group members plus modelId, in model id order (at most COMM_MAX_SLOTS)
+static uint8_t buildGroup(uint8_t modelId, uint8_t ids[COMM_MAX_SLOTS], uint8_t &drivenSlot)
+{
+    uint8_t count = 0;
+    drivenSlot = 0;
+    for (uint8_t id = 0; id < MODEL_COUNT && count < COMM_MAX_SLOTS; ++id)
+    {
+        const bool member = id == modelId || (modelsInGroup(id) && modelsIsBound(id));
+        if (!member)
+            continue;
+        if (id == modelId)
+            drivenSlot = count;
+        ids[count++] = id;
+    }
+    return count;
+}
+
+// Puts modelId on air as the driven receiver, with the rest of its group.
+static void applyModel(uint8_t modelId)
+{
+    uint8_t ids[COMM_MAX_SLOTS];
+    uint8_t addrs[COMM_MAX_SLOTS][5];
+    uint8_t driven = 0;
+    const uint8_t count = buildGroup(modelId, ids, driven);
+    for (uint8_t i = 0; i < count; ++i)
+        modelsGetAddress(ids[i], addrs[i]);
+
+    gCurrent = modelId;
+    receiverSetGroup(ids, addrs, count, driven);
+    mixerLoadModel(modelId);
+
+#if MODELS_DEBUG
+    Serial.print("[MODEL] ");
+    Serial.print(modelId);
+    Serial.print(" slots ");
+    Serial.println(count);
+#endif
+}
+
+static void saveActive()
+{
+    ActiveModelData d{};
+    d.magic = ACTIVE_MAGIC;
+    d.modelId = gActive;
+    d.reserved = 0;
+    d.crc = crcActive(d);
+    storageWriteBlob(STORAGE_KEY_ACTIVE, &d, sizeof(d));
+}
+
+// Called without the control lock: the model record and the switch to it
+// go to flash, so the lock is only held around the radio calls.
+static void finishBind(ModelBindState result)
+{
+    {
+        ControlLockGuard lock;
+        commSetBindMode(false);
+    }
+    gBindState = result;
+
+    if (result == ModelBindState::Done)
+    {
+        ModelData &m = gModels[gBindModel];
+        m.magic = MODEL_MAGIC;
+        m.bound = 1;
+        memcpy(m.address, gBindAddr, 5);
+        m.crc = crcModel(m);
+        char key[12];
+        modelKey(key, sizeof(key), gBindModel);
+        storageWriteBlob(key, &m, sizeof(m));
+
+        modelsSelect(gBindModel);
+    }
+
+    receiverSetLinkEnabled(linkWasEnabled);
+
+#if MODELS_DEBUG
+    Serial.println(result == ModelBindState::Done ? "[BIND] OK" : "[BIND] FAILED");
+#endif
+}
+
+static void bindTick()
+{
+    const uint32_t now = millis();
+    const bool timedOut = now - bindStartMs >= MODEL_BIND_TIMEOUT_MS;
+    CommTxStatus st;
+    {
+        ControlLockGuard lock; // the radio is shared with the control task
+        st = commPollTx(nullptr);
+        if (st != CommTxStatus::Acked && !timedOut &&
+            now - lastOfferMs >= MODEL_BIND_OFFER_MS && commQueueBind(gBindAddr, gBindModel))
+            lastOfferMs = now;
+    }
+
+    if (st == CommTxStatus::Acked)
+        finishBind(ModelBindState::Done);
+    else if (timedOut)
+        finishBind(ModelBindState::Failed);
+}
+
+// While connecting, step to the next bound model after MODEL_SCAN_DWELL_MS.
+// A group is put together on purpose: no scanning then.
+static void scanTick()
+{
+    const uint32_t now = millis();
+    const ReceiverLinkState link = receiverGetLinkState();
+
+    if (receiverGetSlotCount() > 1)
+    {
+        lastScanMs = now;
+        return;
+    }
+
+    if (link == ReceiverLinkState::Connected)
+    {
+        lastScanMs = now;
+        if (gCurrent != gActive)
+        {
+            gActive = gCurrent;
+            saveActive();
+        }
+        return;
+    }
+
+    if (link != ReceiverLinkState::Connecting)
+    {
+        lastScanMs = now;
+        return;
+    }
+
+    if (now - lastScanMs < MODEL_SCAN_DWELL_MS)
+        return;
+    lastScanMs = now;
+
+    for (uint8_t n = 1; n <= MODEL_COUNT; ++n)
+    {
+        const uint8_t id = (uint8_t)((gCurrent + n) % MODEL_COUNT);
+        if (!modelsIsBound(id) && id != gActive)
+            continue;
+        if (id != gCurrent)
+            applyModel(id);
+        return;
+    }
+}
+
+void modelsInit()
+{
+    for (uint8_t i = 0; i < MODEL_COUNT; ++i)
+    {
+        char key[12];
+        modelKey(key, sizeof(key), i);
+        ModelData d{};
+        if (storageReadBlob(key, &d, sizeof(d)) &&
+            d.magic == MODEL_MAGIC && d.crc == crcModel(d))
+        {
+            gModels[i] = d;
+        }
+        else
+        {
+            gModels[i] = ModelData{};
+        }
+    }
+
+    ActiveModelData a{};
+    gActive = 0;
+    if (storageReadBlob(STORAGE_KEY_ACTIVE, &a, sizeof(a)) &&
+        a.magic == ACTIVE_MAGIC && a.crc == crcActive(a) && a.modelId < MODEL_COUNT)
+    {
+        gActive = a.modelId;
+    }
+
+    GroupData g{};
+    gGroupMask = 0;
+    if (storageReadBlob(STORAGE_KEY_GROUP, &g, sizeof(g)) &&
+        g.magic == GROUP_MAGIC && g.crc == crcGroup(g))
+    {
+        gGroupMask = g.mask;
+    }
+
+    gBindState = ModelBindState::Idle;
+    lastScanMs = millis();
+    applyModel(gActive);
+}
+
+void modelsTick()
+{
+    if (gBindState == ModelBindState::Binding)
+    {
+        bindTick();
+        return;
+    }
+    scanTick();
+}
+
+uint8_t modelsGetActive()
+{
+    return gActive;
+}
+
+bool modelsIsBound(uint8_t modelId)
+{
+    return modelId < MODEL_COUNT && gModels[modelId].bound != 0;
+}
+
+void modelsGetAddress(uint8_t modelId, uint8_t address[5])
+{
+    if (modelsIsBound(modelId))
+        memcpy(address, gModels[modelId].address, 5);
+    else
+        memcpy(address, NRF_ADDR_DEFAULT, 5);
+}
+
+void modelsSelect(uint8_t modelId)
+{
+    if (modelId >= MODEL_COUNT)
+        return;
+
+    gActive = modelId;
+    saveActive();
+    lastScanMs = millis();
+    applyModel(modelId);
+}
+
+bool modelsInGroup(uint8_t modelId)
+{
+    return modelId < MODEL_COUNT && (gGroupMask & (1u << modelId)) != 0;
+}
+
+bool modelsSetInGroup(uint8_t modelId, bool member)
+{
+    if (modelId >= MODEL_COUNT || member == modelsInGroup(modelId))
+        return modelId < MODEL_COUNT;
+
+    if (member)
+    {
+        uint8_t ids[COMM_MAX_SLOTS];
+        uint8_t driven = 0;
+        if (!modelsIsBound(modelId) || buildGroup(gActive, ids, driven) >= COMM_MAX_SLOTS)
+            return false;
+        gGroupMask = (uint8_t)(gGroupMask | (1u << modelId));
+    }
+    else
+    {
+        gGroupMask = (uint8_t)(gGroupMask & ~(1u << modelId));
+    }
+
+    saveGroup();
+    applyModel(gActive);
+    return true;
+}
+
+void modelsBindStart(uint8_t modelId)
+{
+    if (modelId >= MODEL_COUNT || gBindState == ModelBindState::Binding)
+        return;
+
+    ControlLockGuard lock;
+    linkWasEnabled = receiverIsLinkEnabled();
+    receiverSetLinkEnabled(false); // the control task leaves the radio alone
+    if (!commSetBindMode(true))
+    {
+        gBindState = ModelBindState::Failed;
+        receiverSetLinkEnabled(linkWasEnabled);
+        return;
+    }
+
+    gBindModel = modelId;
+    deriveAddress(modelId, gBindAddr);
+    bindStartMs = millis();
+    lastOfferMs = 0;
+    gBindState = ModelBindState::Binding;
+
+#if MODELS_DEBUG
+    Serial.print("[BIND] model ");
+    Serial.println(modelId);
+#endif
+}
+
+void modelsBindCancel()
+{
+    // finishBind() locks around the radio itself, not across its flash writes
+    if (gBindState == ModelBindState::Binding)
+        finishBind(ModelBindState::Failed);
+    gBindState = ModelBindState::Idle;
+}
+
+ModelBindState modelsBindState()
+{
+    return gBindState;
+}
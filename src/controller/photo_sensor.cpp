@@ -3,6 +3,8 @@
 #include "controller/photo_sensor.h"
 #include "controller/config.h"
 #include "controller/storage.h"
+#include "controller/adc_sampler.h"
+#include "common/input_filter.h"
 
 namespace
 {
@@ -22,6 +24,7 @@ struct StoredPhotoConfig
 
 constexpr uint16_t kPhotoMagic = 0x5048;
 constexpr const char *kStorageKeyPhoto = "photo_cfg";
+constexpr uint32_t kFilterTickMs = 50;
 
 PhotoSensorConfig g_config{
     0,
@@ -35,7 +38,8 @@ PhotoSensorConfig g_config{
 
 bool g_filterInitialized = false;
 uint32_t g_lastFilterMs = 0;
-int32_t g_filteredPctX256 = 0;
+InputFilter g_filter;
+uint8_t g_filteredPct = 0;
 uint8_t g_lastOutputPct = 0;
 
 uint16_t crcPhoto(const StoredPhotoConfig &d)
@@ -105,19 +109,19 @@ uint8_t mapRawToLedPct(int raw, const PhotoSensorConfig &cfg)
     return (uint8_t)ledPct;
 }
 
-uint8_t filterShift(PhotoFilterLevel level)
+InputFilterConfig filterConfig(PhotoFilterLevel level)
 {
     switch (level)
     {
     case PhotoFilterLevel::Off:
-        return 0;
+        return InputFilterConfig{InputFilterType::Off, 1};
     case PhotoFilterLevel::Low:
-        return 3; // 1/8
+        return InputFilterConfig{InputFilterType::Ema, 3}; // 1/8
     case PhotoFilterLevel::Med:
-        return 4; // 1/16
+        return InputFilterConfig{InputFilterType::Ema, 4}; // 1/16
     case PhotoFilterLevel::High:
     default:
-        return 5; // 1/32
+        return InputFilterConfig{InputFilterType::Ema, 5}; // 1/32
     }
 }
 
@@ -140,8 +144,6 @@ uint8_t hysteresisThreshold(PhotoHysteresisLevel level)
 
 void photoSensorInit()
 {
-    pinMode(PHOTO_PIN, INPUT);
-
     StoredPhotoConfig stored{};
     if (storageReadBlob(kStorageKeyPhoto, &stored, sizeof(stored)) &&
         stored.magic == kPhotoMagic &&
@@ -163,12 +165,7 @@ void photoSensorInit()
 
 int photoSensorReadRaw()
 {
-    int raw = analogRead(PHOTO_PIN);
-    if (raw < 0)
-        raw = 0;
-    if (raw > ADC_MAX)
-        raw = ADC_MAX;
-    return raw;
+    return adcSamplerRaw(PHOTO_PIN);
 }
 
 uint8_t photoSensorReadPct()
@@ -196,26 +193,21 @@ uint8_t photoSensorLedBrightnessPct()
     {
         g_filterInitialized = true;
         g_lastFilterMs = now;
-        g_filteredPctX256 = (int32_t)livePct << 8;
+        g_filter.configure(filterConfig(cfg.filter), 1000 / kFilterTickMs);
+        g_filteredPct = (uint8_t)g_filter.update(livePct); // first sample passes through
         g_lastOutputPct = livePct;
         return livePct;
     }
 
-    if (now - g_lastFilterMs >= 50)
+    if (now - g_lastFilterMs >= kFilterTickMs)
     {
         g_lastFilterMs = now;
-        const uint8_t shift = filterShift(cfg.filter);
-        const int32_t target = (int32_t)livePct << 8;
-        if (shift == 0)
-            g_filteredPctX256 = target;
-        else
-            g_filteredPctX256 += (target - g_filteredPctX256) >> shift;
+        g_filteredPct = (uint8_t)g_filter.update(livePct);
     }
 
-    const uint8_t filteredPct = (uint8_t)((g_filteredPctX256 + 128) >> 8);
     const uint8_t threshold = hysteresisThreshold(cfg.hysteresis);
-    if (threshold == 0 || abs((int)filteredPct - (int)g_lastOutputPct) >= (int)threshold)
-        g_lastOutputPct = filteredPct;
+    if (threshold == 0 || abs((int)g_filteredPct - (int)g_lastOutputPct) >= (int)threshold)
+        g_lastOutputPct = g_filteredPct;
 
     return g_lastOutputPct;
 }
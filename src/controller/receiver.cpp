@@ -1,22 +1,27 @@
 #include <Arduino.h>
 #include "controller/config.h"
 #include "common/comm.h"
+#include "common/telemetry.h"
+#include "common/input_filter.h"
 #include "controller/receiver.h"
 #include "controller/leds.h"
 #include "controller/photo_sensor.h"
+#include "controller/storage.h"
+#include "controller/link_quality.h"
+#include "controller/control_task.h"
+#include "common/spsc_queue.h"
 
 // ==================== Debug ====================
-#define BATTERY_DEBUG 1 // 1 = print debug to Serial (USB), 0 = off
-#define LINK_DEBUG 1    // 1 = print link state changes to Serial (USB), 0 = off
+#define BATTERY_DEBUG 0 // 1 = print debug to Serial (USB), 0 = off
+#define LINK_DEBUG 0    // 1 = print link state changes to Serial (USB), 0 = off
 
 // ==================== Timing ====================
-static const uint32_t TX_TICK_MS = 20;     // 50 Hz TX
-static const uint32_t LED_TICK_MS = 10;    // 50 Hz LED update
 static const uint32_t RX_TIMEOUT_MS = 120; // failsafe: if no valid RX frame for this long
 static const uint32_t LINK_LED_BLINK_MS = 250;
 
 // ==================== Filtering ====================
-static const uint8_t EMA_SHIFT = 2; // EMA: 1/8
+static const InputFilterConfig BATTERY_MEDIAN = {InputFilterType::Median, 1}; // 3 taps, glitch killer
+static const InputFilterConfig BATTERY_EMA = {InputFilterType::Ema, 2};       // 1/4 per LED tick
 
 // Snap ends to avoid faint glow near 0 due to noise/EMA tail
 static const uint8_t BATTERY_SNAP_LOW = 1;   // <1  -> 0
@@ -25,18 +30,75 @@ static const uint8_t BATTERY_SNAP_HIGH = 99; // >99 -> 100
 // ==================== State ====================
 static uint16_t batteryPctTarget = 0; // filtered target (0..100)
 static uint16_t batteryPctSmooth = 0; // EMA output (0..100)
+static InputFilter gBatteryMedian;    // per telemetry item
+static InputFilter gBatteryEma;       // per LED tick
 
 static bool gRadioReady = false;
 static bool gLinkEnabled = false;
-static ReceiverLinkState gLinkState = ReceiverLinkState::Idle;
 
-static uint32_t lastTxMs = 0;
-static uint32_t lastLedMs = 0;
-static uint32_t lastRxOkMs = 0;
 
-// Median-of-3 history (glitch killer)
-static uint16_t s0 = 0, s1 = 0, s2 = 0;
-static bool samplesInit = false;
+// TX cadence comes from the active link profile
+static CommLinkProfile gLinkProfile = (CommLinkProfile)LINK_PROFILE_DEFAULT;
+static uint32_t gTxPeriodUs = 20000UL;
+
+struct LinkData
+{
+    uint16_t magic;
+    uint8_t profile;
+    uint8_t reserved;
+    uint16_t crc;
+};
+
+static const uint16_t LINK_MAGIC = 0x11C0;
+static const char *STORAGE_KEY_LINK = "link_cfg";
+
+// Receiver failsafe, pushed over the link every FAILSAFE_PUSH_INTERVAL_MS
+struct FailsafeData
+{
+    uint16_t magic;
+    CommFailsafeConfig cfg;
+    uint16_t crc;
+};
+
+static const uint16_t FAILSAFE_MAGIC = 0xF5A1;
+static const char *STORAGE_KEY_FAILSAFE = "fs_cfg";
+
+// Latest value of every downlink telemetry item
+struct TelemetryEntry
+{
+    uint32_t value;
+    uint32_t updatedMs;
+    bool valid;
+};
+
+/*
+ * Time slots: every receiver in the group is a slot with its own link
+ * state, failsafe and telemetry. Tick k of the link profile period goes
+ * to slot k % gSlotCount, so each receiver gets a frame at a fixed rate
+ * (profile rate / slot count). The driven slot sends the sticks, the
+ * others repeat the last frame they got (hold).
+ *
+ * Link profile and failsafe are stored per model; model 0 keeps the original keys.
+ * The link profile is shared by the whole group and comes from the driven model.
+ */
+struct RxSlot
+{
+    uint8_t modelId;
+    ReceiverLinkState state;
+    uint32_t lastRxOkMs;
+    CommFrame lastSent; // repeated while another slot is driven
+    CommFailsafeConfig failsafe;
+    uint32_t lastFailsafePushMs;
+    bool failsafePushNow;
+    TelemetryEntry telemetry[TELEMETRY_ID_COUNT];
+};
+
+static RxSlot gSlots[COMM_MAX_SLOTS] = {};
+static uint8_t gSlotCount = 1;
+static uint8_t gDriven = 0;
+static uint32_t gTick = 0;
+static int8_t gInFlightSlot = -1;
+static ReceiverLinkState gLinkState = ReceiverLinkState::Idle; // without a link, shared by all slots
 
 static const char *linkStateName(ReceiverLinkState state)
 {
@@ -56,19 +118,101 @@ static const char *linkStateName(ReceiverLinkState state)
     return "UNKNOWN";
 }
 
-static void setLinkState(ReceiverLinkState state)
+// Debug lines are queued by the radio side (control task or control lock
+// held) and printed by receiverLedTick() on the UI task, so the control
+// tick never waits on Serial.
+#if LINK_DEBUG || BATTERY_DEBUG
+enum class RxLogType : uint8_t
 {
-    if (gLinkState == state)
+    SlotState, // a = slot, b = ReceiverLinkState
+    Profile,   // a = CommLinkProfile
+    Group,     // a = slot count, b = driven model
+    Battery,   // v = raw, target, smooth
+};
+
+struct RxLogEvent
+{
+    RxLogType type;
+    uint8_t a;
+    uint8_t b;
+    uint16_t v[3];
+};
+
+static SpscQueue<RxLogEvent, 32> gLog; // full: the line is dropped
+
+static void logEvent(RxLogType type, uint8_t a, uint8_t b, uint16_t v0 = 0, uint16_t v1 = 0, uint16_t v2 = 0)
+{
+    RxLogEvent e{type, a, b, {v0, v1, v2}};
+    gLog.push(e);
+}
+
+static void printLog(const RxLogEvent &e)
+{
+    switch (e.type)
+    {
+    case RxLogType::SlotState:
+        Serial.print("[LINK] ");
+        if (gSlotCount > 1)
+        {
+            Serial.print("slot ");
+            Serial.print(e.a);
+            Serial.print(" ");
+        }
+        Serial.println(linkStateName((ReceiverLinkState)e.b));
+        break;
+    case RxLogType::Profile:
+        Serial.print("[LINK] profile ");
+        Serial.print(commGetLinkProfileInfo((CommLinkProfile)e.a).name);
+        Serial.print(" ");
+        Serial.print(commGetLinkProfileInfo((CommLinkProfile)e.a).rateHz);
+        Serial.println(" Hz");
+        break;
+    case RxLogType::Group:
+        Serial.print("[LINK] group ");
+        Serial.print(e.a);
+        Serial.print(" driven model ");
+        Serial.println(e.b);
+        break;
+    case RxLogType::Battery:
+        Serial.print("[RX BATT] rawPct=");
+        Serial.print((unsigned)e.v[0]);
+        Serial.print(" target=");
+        Serial.print((unsigned)e.v[1]);
+        Serial.print(" smooth=");
+        Serial.print((unsigned)e.v[2]);
+        Serial.println();
+        break;
+    }
+}
+#endif
+
+static void setSlotState(uint8_t slot, ReceiverLinkState state)
+{
+    RxSlot &s = gSlots[slot];
+    if (s.state == state)
         return;
 
-    gLinkState = state;
+    s.state = state;
 
 #if LINK_DEBUG
-    Serial.print("[LINK] ");
-    Serial.println(linkStateName(state));
+    logEvent(RxLogType::SlotState, slot, (uint8_t)state);
 #endif
 }
 
+static void setLinkState(ReceiverLinkState state)
+{
+    gLinkState = state;
+    for (uint8_t i = 0; i < gSlotCount; ++i)
+        setSlotState(i, state);
+}
+
+// A slot is heard at most every gSlotCount periods
+static uint32_t slotTimeoutMs()
+{
+    const uint32_t t = 6UL * gSlotCount * gTxPeriodUs / 1000UL;
+    return t > RX_TIMEOUT_MS ? t : RX_TIMEOUT_MS;
+}
+
 static uint16_t clampAndSnap(uint16_t v)
 {
     if (v > 100)
@@ -80,28 +224,67 @@ static uint16_t clampAndSnap(uint16_t v)
     return v;
 }
 
-static uint16_t median3(uint16_t a, uint16_t b, uint16_t c)
+static uint16_t crcLink(const LinkData &d)
 {
-    // Return median (middle) of three values
-    if (a > b)
-    {
-        uint16_t t = a;
-        a = b;
-        b = t;
-    }
-    if (b > c)
+    return (uint16_t)(d.magic ^ d.profile ^ d.reserved ^ 0x3CC3);
+}
+
+static uint16_t crcFailsafe(const FailsafeData &d)
+{
+    const uint8_t *p = (const uint8_t *)&d.cfg;
+    uint16_t crc = (uint16_t)(d.magic ^ 0x5AF5);
+    for (size_t i = 0; i < sizeof(d.cfg); ++i)
+        crc = (uint16_t)(((crc << 1) | (crc >> 15)) ^ p[i]);
+    return crc;
+}
+
+static void failsafeDefaults(CommFailsafeConfig &cfg)
+{
+    cfg = CommFailsafeConfig{};
+    cfg.missedPeriods = FAILSAFE_MISSED_PERIODS_DEFAULT;
+    cfg.channelCount = COMM_CH_DEFAULT_COUNT;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
     {
-        uint16_t t = b;
-        b = c;
-        c = t;
+        cfg.mode[i] = CommFailsafeMode::Hold;
+        cfg.value[i] = COMM_CH_CENTER;
     }
-    if (a > b)
+}
+
+static void modelKey(char *dst, size_t size, const char *base, uint8_t modelId)
+{
+    if (modelId == 0)
+        snprintf(dst, size, "%s", base);
+    else
+        snprintf(dst, size, "%s%u", base, (unsigned)modelId);
+}
+
+static void sanitizeFailsafe(CommFailsafeConfig &cfg)
+{
+    if (cfg.missedPeriods == 0)
+        cfg.missedPeriods = 1;
+    if (cfg.channelCount == 0 || cfg.channelCount > COMM_MAX_CHANNELS)
+        cfg.channelCount = COMM_CH_DEFAULT_COUNT;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
     {
-        uint16_t t = a;
-        a = b;
-        b = t;
+        if ((uint8_t)cfg.mode[i] >= (uint8_t)CommFailsafeMode::Count)
+            cfg.mode[i] = CommFailsafeMode::Hold;
+        if (cfg.value[i] < COMM_CH_MIN || cfg.value[i] > COMM_CH_MAX)
+            cfg.value[i] = COMM_CH_CENTER;
     }
-    return b;
+}
+
+static void applyLinkProfile(CommLinkProfile profile)
+{
+    if ((uint8_t)profile >= (uint8_t)CommLinkProfile::Count)
+        profile = CommLinkProfile::Robust50;
+
+    gLinkProfile = profile;
+    gTxPeriodUs = commGetLinkProfileInfo(profile).txPeriodUs;
+    commSetLinkProfile(profile);
+
+#if LINK_DEBUG
+    logEvent(RxLogType::Profile, (uint8_t)profile, 0);
+#endif
 }
 
 static void updateLinkLed()
@@ -110,7 +293,7 @@ static void updateLinkLed()
     const bool blinkOn = ((millis() / LINK_LED_BLINK_MS) % 2U) == 0U;
     Color c = OFF;
 
-    switch (gLinkState)
+    switch (receiverGetLinkState())
     {
     case ReceiverLinkState::Idle:
         c = YELLOW;
@@ -134,19 +317,14 @@ static void updateLinkLed()
 
 static void updateLed()
 {
-    uint32_t now = millis();
-    if (now - lastLedMs < LED_TICK_MS)
-        return;
-    lastLedMs = now;
+    const uint32_t now = millis();
 
-    if (!gLinkEnabled || now - lastRxOkMs > RX_TIMEOUT_MS)
+    if (!gLinkEnabled || now - gSlots[gDriven].lastRxOkMs > slotTimeoutMs())
     {
         batteryPctTarget = 0; // fallback to 0% => blue
     }
 
-    // EMA smoothing (MUST be signed to avoid uint underflow)
-    int32_t delta = (int32_t)batteryPctTarget - (int32_t)batteryPctSmooth; // can be negative
-    batteryPctSmooth = (uint16_t)((int32_t)batteryPctSmooth + (delta >> EMA_SHIFT));
+    batteryPctSmooth = gBatteryEma.update(batteryPctTarget);
 
     // Clamp just in case (should already be 0..100)
     if (batteryPctSmooth > 100)
@@ -162,6 +340,60 @@ static void updateLed()
     ledsSet(LedSlot::Third, c, photoSensorLedBrightnessPct());
 }
 
+// Storage reads (NVS) are done before the control lock is taken: a flash
+// read would stall the control task for its whole duration.
+static CommLinkProfile readLinkProfile(uint8_t modelId)
+{
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_LINK, modelId);
+    LinkData d{};
+    if (storageReadBlob(key, &d, sizeof(d)) &&
+        d.magic == LINK_MAGIC && d.crc == crcLink(d))
+    {
+        return (CommLinkProfile)d.profile;
+    }
+    return (CommLinkProfile)LINK_PROFILE_DEFAULT;
+}
+
+static void readFailsafe(uint8_t modelId, CommFailsafeConfig &cfg)
+{
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_FAILSAFE, modelId);
+    FailsafeData fs{};
+    if (storageReadBlob(key, &fs, sizeof(fs)) &&
+        fs.magic == FAILSAFE_MAGIC && fs.crc == crcFailsafe(fs))
+    {
+        cfg = fs.cfg;
+    }
+    else
+    {
+        failsafeDefaults(cfg);
+    }
+    sanitizeFailsafe(cfg);
+}
+
+static void resetSlot(uint8_t slot, uint8_t modelId, const CommFailsafeConfig &failsafe)
+{
+    RxSlot &s = gSlots[slot];
+    s = RxSlot{};
+    s.modelId = modelId;
+    s.state = gLinkEnabled ? ReceiverLinkState::Connecting : gLinkState;
+    s.lastRxOkMs = millis();
+    s.failsafePushNow = true;
+    s.failsafe = failsafe;
+
+    // Nothing to hold yet: cut outputs until the slot is driven once
+    s.lastSent.channelCount = COMM_CH_DEFAULT_COUNT;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+        s.lastSent.ch[i] = COMM_CH_CUT;
+}
+
+static void resetDrivenFilters()
+{
+    gBatteryMedian.reset();
+    linkQualityReset();
+}
+
 void receiverInit(bool radioReady)
 {
     gRadioReady = radioReady;
@@ -169,19 +401,99 @@ void receiverInit(bool radioReady)
 
     batteryPctTarget = 0;
     batteryPctSmooth = 0;
+    gBatteryMedian.configure(BATTERY_MEDIAN, 1); // fed per item, rate only scales the delay
+    gBatteryEma.configure(BATTERY_EMA, 1000 / LEDS_TICK_MS);
+    gBatteryEma.update(0); // start from 0 % and ramp up
 
-    lastTxMs = 0;
-    lastLedMs = 0;
-    lastRxOkMs = millis();
+    gTick = 0;
+    gInFlightSlot = -1;
 
-    s0 = s1 = s2 = 0;
-    samplesInit = false;
+    resetDrivenFilters();
 
+    gSlotCount = 1;
+    gDriven = 0;
+    CommFailsafeConfig fs{};
+    readFailsafe(0, fs);
+    resetSlot(0, 0, fs);
+    applyLinkProfile(readLinkProfile(0));
     setLinkState(gRadioReady ? ReceiverLinkState::Idle : ReceiverLinkState::RadioError);
 }
 
+void receiverSetGroup(const uint8_t *modelIds, const uint8_t (*addresses)[5], uint8_t count, uint8_t drivenSlot)
+{
+    if (count == 0)
+        return;
+    if (count > COMM_MAX_SLOTS)
+        count = COMM_MAX_SLOTS;
+    if (drivenSlot >= count)
+        drivenSlot = 0;
+
+    // The group is only changed here (UI task), so it can be compared unlocked
+    const uint8_t prevDrivenModel = gSlots[gDriven].modelId;
+    bool sameGroup = (count == gSlotCount);
+    for (uint8_t i = 0; sameGroup && i < count; ++i)
+        sameGroup = (gSlots[i].modelId == modelIds[i]);
+    const bool newDriven = !sameGroup || modelIds[drivenSlot] != prevDrivenModel;
+
+    // Flash first, then the lock only to swap the results in
+    CommFailsafeConfig failsafe[COMM_MAX_SLOTS];
+    if (!sameGroup)
+    {
+        for (uint8_t i = 0; i < count; ++i)
+            readFailsafe(modelIds[i], failsafe[i]);
+    }
+    const CommLinkProfile profile = newDriven ? readLinkProfile(modelIds[drivenSlot]) : gLinkProfile;
+
+    ControlLockGuard lock;
+    for (uint8_t i = 0; i < count; ++i)
+        commSetSlotAddress(i, addresses[i]);
+
+    // Unchanged members keep their link state and telemetry
+    if (!sameGroup)
+    {
+        gSlotCount = count;
+        for (uint8_t i = 0; i < count; ++i)
+            resetSlot(i, modelIds[i], failsafe[i]);
+        gTick = 0;
+        gInFlightSlot = -1; // its ACK would land on the wrong receiver
+    }
+
+    gDriven = drivenSlot;
+    if (newDriven)
+    {
+        applyLinkProfile(profile);
+        resetDrivenFilters();
+        batteryPctTarget = 0;
+    }
+
+#if LINK_DEBUG
+    logEvent(RxLogType::Group, count, modelIds[drivenSlot]);
+#endif
+}
+
+uint8_t receiverGetModel()
+{
+    return gSlots[gDriven].modelId;
+}
+
+uint8_t receiverGetSlotCount()
+{
+    return gSlotCount;
+}
+
+uint8_t receiverGetDrivenSlot()
+{
+    return gDriven;
+}
+
+uint8_t receiverGetSlotModel(uint8_t slot)
+{
+    return slot < gSlotCount ? gSlots[slot].modelId : 0;
+}
+
 void receiverSetLinkEnabled(bool enabled)
 {
+    ControlLockGuard lock;
     if (!gRadioReady)
     {
         gLinkEnabled = false;
@@ -196,10 +508,74 @@ void receiverSetLinkEnabled(bool enabled)
         return;
     }
 
-    lastRxOkMs = millis();
+    linkQualityReset();
+    for (uint8_t i = 0; i < gSlotCount; ++i)
+    {
+        gSlots[i].lastRxOkMs = millis();
+        gSlots[i].failsafePushNow = true;
+    }
     setLinkState(ReceiverLinkState::Connecting);
 }
 
+CommLinkProfile receiverGetLinkProfile()
+{
+    return gLinkProfile;
+}
+
+void receiverSetLinkProfile(CommLinkProfile profile)
+{
+    ControlLockGuard lock;
+    if (profile == gLinkProfile)
+        return;
+
+    applyLinkProfile(profile);
+
+    // Receivers need a moment to scan to the new profile
+    if (gLinkEnabled)
+    {
+        for (uint8_t i = 0; i < gSlotCount; ++i)
+            gSlots[i].lastRxOkMs = millis();
+        setLinkState(ReceiverLinkState::Connecting);
+    }
+}
+
+void receiverSaveLinkProfile()
+{
+    LinkData d{};
+    d.magic = LINK_MAGIC;
+    d.profile = (uint8_t)gLinkProfile;
+    d.reserved = 0;
+    d.crc = crcLink(d);
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_LINK, gSlots[gDriven].modelId);
+    storageWriteBlob(key, &d, sizeof(d));
+}
+
+const CommFailsafeConfig &receiverGetFailsafeConfig()
+{
+    return gSlots[gDriven].failsafe;
+}
+
+void receiverSetFailsafeConfig(const CommFailsafeConfig &cfg)
+{
+    ControlLockGuard lock;
+    RxSlot &s = gSlots[gDriven];
+    s.failsafe = cfg;
+    sanitizeFailsafe(s.failsafe);
+    s.failsafePushNow = true;
+}
+
+void receiverSaveFailsafeConfig()
+{
+    FailsafeData d{};
+    d.magic = FAILSAFE_MAGIC;
+    d.cfg = gSlots[gDriven].failsafe;
+    d.crc = crcFailsafe(d);
+    char key[16];
+    modelKey(key, sizeof(key), STORAGE_KEY_FAILSAFE, gSlots[gDriven].modelId);
+    storageWriteBlob(key, &d, sizeof(d));
+}
+
 bool receiverIsLinkEnabled()
 {
     return gLinkEnabled;
@@ -207,12 +583,24 @@ bool receiverIsLinkEnabled()
 
 ReceiverLinkState receiverGetLinkState()
 {
-    return gLinkState;
+    return receiverGetSlotLinkState(gDriven);
+}
+
+ReceiverLinkState receiverGetSlotLinkState(uint8_t slot)
+{
+    if (!gRadioReady || !gLinkEnabled || slot >= gSlotCount)
+        return gLinkState;
+    return gSlots[slot].state;
 }
 
 const char *receiverGetLinkStateShortName()
 {
-    switch (gLinkState)
+    return receiverGetLinkStateShortName(receiverGetLinkState());
+}
+
+const char *receiverGetLinkStateShortName(ReceiverLinkState state)
+{
+    switch (state)
     {
     case ReceiverLinkState::Idle:
         return "IDLE";
@@ -228,85 +616,189 @@ const char *receiverGetLinkStateShortName()
     return "ERR";
 }
 
-void receiverLoop(const CommFrame &txFrame)
+struct TelemetryDecodeCtx
+{
+    TelemetryEntry *table;
+    uint32_t nowMs;
+    bool gotBattery;
+};
+
+static void onTelemetryItem(TelemetryId id, uint32_t value, void *ctx)
+{
+    TelemetryDecodeCtx *c = (TelemetryDecodeCtx *)ctx;
+    const uint8_t i = (uint8_t)id;
+    if (i >= TELEMETRY_ID_COUNT)
+        return;
+
+    c->table[i].value = value;
+    c->table[i].updatedMs = c->nowMs;
+    c->table[i].valid = true;
+    if (id == TelemetryId::RxBattPct)
+        c->gotBattery = true;
+}
+
+// Sends the slot its frame: sticks when driven, hold otherwise.
+// Failsafe config chunks take the slot's turn at a low rate.
+// sentControls: txFrame itself went out (driven slot, no failsafe push).
+static bool queueSlot(uint8_t slot, const CommFrame &txFrame, uint32_t now, bool &sentControls)
 {
-    uint32_t now = millis();
+    sentControls = false;
+    RxSlot &s = gSlots[slot];
+    if (!commSelectSlot(slot))
+        return false;
+
+    if (slot == gDriven)
+        s.lastSent = txFrame;
+
+    const bool pushFailsafe = s.failsafePushNow || now - s.lastFailsafePushMs >= FAILSAFE_PUSH_INTERVAL_MS;
+    if (pushFailsafe)
+    {
+        if (!commQueueFailsafe(s.failsafe))
+            return false;
+        s.lastFailsafePushMs = now;
+        s.failsafePushNow = false;
+    }
+    else if (!commQueueFrame(s.lastSent))
+    {
+        return false;
+    }
+    else
+    {
+        sentControls = (slot == gDriven);
+    }
+
+    gInFlightSlot = (int8_t)slot;
+    return true;
+}
+
+void receiverPoll()
+{
+    const uint32_t now = millis();
 
     if (!gRadioReady)
     {
         setLinkState(ReceiverLinkState::RadioError);
-        updateLed();
         return;
     }
 
     if (!gLinkEnabled)
     {
         setLinkState(ReceiverLinkState::Idle);
-        updateLed();
         return;
     }
 
-    // ===== TX max 50 Hz + ACK telemetry =====
-    CommFrame rx{};
+    // ===== ACK telemetry =====
     bool got = false;
     uint16_t lastRaw = batteryPctTarget;
 
-    if (now - lastTxMs >= TX_TICK_MS)
+    // Collect completion of the frame in flight (never waits for the air)
+    CommTxInfo txInfo{};
+    const CommTxStatus txStatus = commPollTx(&txInfo);
+    const int8_t doneSlot = gInFlightSlot;
+    if (txStatus == CommTxStatus::Acked || txStatus == CommTxStatus::Failed)
+        gInFlightSlot = -1;
+
+    // Link quality describes the driven receiver only
+    if (doneSlot == (int8_t)gDriven)
+        linkQualityOnTx(txStatus, txInfo);
+
+    if (txStatus == CommTxStatus::Acked && doneSlot >= 0 && doneSlot < (int8_t)gSlotCount)
     {
-        lastTxMs = now;
-        if (commSendFrame(txFrame, &rx))
+        RxSlot &s = gSlots[doneSlot];
+        s.lastRxOkMs = now; // receiver heard us
+        setSlotState((uint8_t)doneSlot, ReceiverLinkState::Connected);
+
+        if (txInfo.ackPayload)
         {
-            uint16_t v = clampAndSnap(rx.battPct);
-            lastRaw = v;
-            got = true;
-            lastRxOkMs = now; // we got valid ACK telemetry
-            setLinkState(ReceiverLinkState::Connected);
+            TelemetryDecodeCtx ctx{s.telemetry, now, false};
+            telemetryDecode(txInfo.telemetry, txInfo.telemetryLen, onTelemetryItem, &ctx);
+
+            // Battery filter is fed only when the item was in this payload
+            if (ctx.gotBattery && doneSlot == (int8_t)gDriven)
+            {
+                lastRaw = clampAndSnap((uint16_t)s.telemetry[(uint8_t)TelemetryId::RxBattPct].value);
+                got = true;
+            }
         }
     }
 
-    // Apply median-of-3 glitch filter
+    // Median-of-3 glitch filter
     if (got)
-    {
-        if (!samplesInit)
-        {
-            s0 = s1 = s2 = lastRaw;
-            samplesInit = true;
-        }
-        else
-        {
-            s0 = s1;
-            s1 = s2;
-            s2 = lastRaw;
-        }
-
-        batteryPctTarget = median3(s0, s1, s2);
-    }
+        batteryPctTarget = gBatteryMedian.update(lastRaw);
 
-    if (!got && gLinkState == ReceiverLinkState::Connected && now - lastRxOkMs > RX_TIMEOUT_MS)
+    for (uint8_t i = 0; i < gSlotCount; ++i)
     {
-        setLinkState(ReceiverLinkState::Lost);
+        if (gSlots[i].state == ReceiverLinkState::Connected && now - gSlots[i].lastRxOkMs > slotTimeoutMs())
+            setSlotState(i, ReceiverLinkState::Lost);
     }
 
-    // Update LED (no ledsShow() here)
-    updateLed();
-
 #if BATTERY_DEBUG
-    // Print comm stats + values at low rate
+    // Values at low rate
     static uint32_t dbgTick = 0;
     if (now - dbgTick >= 500)
     {
         dbgTick = now;
-        Serial.print("[RX BATT] rawPct=");
-        Serial.print((unsigned)lastRaw);
-        Serial.print(" target=");
-        Serial.print((unsigned)batteryPctTarget);
-        Serial.print(" smooth=");
-        Serial.print((unsigned)batteryPctSmooth);
-        Serial.println();
+        logEvent(RxLogType::Battery, 0, 0, lastRaw, batteryPctTarget, batteryPctSmooth);
     }
 #endif
 }
 
+bool receiverSend(const CommFrame &txFrame, uint32_t ticks)
+{
+    if (!gRadioReady || !gLinkEnabled || ticks == 0)
+        return false;
+
+    // The tick's slot loses its turn while the previous frame is still
+    // retrying; missed ticks move the hop sequence on as well (it wraps
+    // every COMM_HOP_COUNT hops, so any number of them stays on time)
+    const uint32_t missed = ticks - 1U;
+    for (uint32_t k = 0; k < missed % COMM_HOP_COUNT; ++k)
+        commSkipHop();
+    gTick += missed;
+
+    const uint8_t slot = (uint8_t)(gTick % gSlotCount);
+    gTick++;
+    bool sentControls = false;
+    if (!queueSlot(slot, txFrame, millis(), sentControls))
+        commSkipHop();
+    return sentControls;
+}
+
+uint32_t receiverGetTxPeriodUs()
+{
+    return gTxPeriodUs;
+}
+
+void receiverLedTick()
+{
+    updateLed();
+
+#if LINK_DEBUG || BATTERY_DEBUG
+    RxLogEvent e;
+    while (gLog.pop(e))
+        printLog(e);
+#endif
+}
+
+bool receiverGetTelemetry(TelemetryId id, uint32_t &value, uint32_t *ageMs)
+{
+    return receiverGetSlotTelemetry(gDriven, id, value, ageMs);
+}
+
+bool receiverGetSlotTelemetry(uint8_t slot, TelemetryId id, uint32_t &value, uint32_t *ageMs)
+{
+    ControlLockGuard lock;
+    const uint8_t i = (uint8_t)id;
+    if (slot >= gSlotCount || i >= TELEMETRY_ID_COUNT || !gSlots[slot].telemetry[i].valid)
+        return false;
+
+    const TelemetryEntry &e = gSlots[slot].telemetry[i];
+    value = e.value;
+    if (ageMs)
+        *ageMs = millis() - e.updatedMs;
+    return true;
+}
+
 uint16_t receiverGetBatteryPct()
 {
     return batteryPctTarget;
@@ -1,37 +1,18 @@
 #include "controller/tx_frame.h"
 
-#include "controller/buttons.h"
-#include "controller/joysticks.h"
-
-static int8_t controlToTx(float v)
-{
-    if (v > 100.0f)
-        v = 100.0f;
-    if (v < -100.0f)
-        v = -100.0f;
-    return (int8_t)((v >= 0.0f) ? (v + 0.5f) : (v - 0.5f));
-}
+#include "controller/input_snapshot.h"
+#include "controller/mixer.h"
 
 CommFrame txFrameBuild(bool sendLiveControls)
 {
-    CommFrame tx{
-        0,
-        0,
-        0,
-        0,
-        0u,
-        0u};
+    CommFrame tx{};
+    tx.channelCount = mixerGetConfig().channelCount;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+        tx.ch[i] = (i < COMM_CH_AUX_JL || i >= COMM_CH_DEFAULT_COUNT) ? COMM_CH_CENTER : COMM_CH_MIN;
 
     if (!sendLiveControls)
         return tx;
 
-    tx.lx = controlToTx(joyL.readX());
-    tx.ly = controlToTx(joyL.readY());
-    tx.rx = controlToTx(joyR.readX());
-    tx.ry = controlToTx(joyR.readY());
-    if (keyDown(Key::JL))
-        tx.joyButtons |= 0x01u;
-    if (keyDown(Key::JR))
-        tx.joyButtons |= 0x02u;
+    mixerEvaluate(inputSnapshot(), tx);
     return tx;
 }
@@ -1,18 +1,19 @@
 #include <Arduino.h>
 #include "common/time_utils.h"
 #include "controller/ui/loop_main.h"
-#include "controller/joysticks.h"
+#include "controller/input_snapshot.h"
 #include "controller/photo_sensor.h"
 #include "controller/leds.h"
 #include "controller/receiver.h"
+#include "controller/link_quality.h"
 #include "controller/battery.h"
 #include "controller/buttons.h"
 #include "controller/ui/menu.h"
 #include "controller/config.h"
 
 static uint32_t oledTick = 0;
-static uint8_t page = 1; // 1=DASH, 2=MAIN, 3=L, 4=R, 5=PHOTO, 6=SETTINGS
-static const uint8_t totalPages = 6;
+static uint8_t page = 1; // 1=DASH, 2=MAIN, 3=L, 4=R, 5=PHOTO, 6=TELEMETRY, 7=SETTINGS
+static const uint8_t totalPages = 7;
 static bool splashInit = false;
 static bool splashActive = true;
 static uint32_t splashUntilMs = 0;
@@ -21,13 +22,18 @@ static bool settingsArmed = false;
 static uint8_t prevPage = 1;
 static DashboardArmState armState = DashboardArmState::Safe;
 
-static int16_t displayPct(float v)
+// Age suffix for telemetry lines: seconds since the item was received, capped at 99
+static unsigned telemetryAgeS(uint32_t ageMs)
 {
-    if (v > 100.0f)
-        v = 100.0f;
-    if (v < -100.0f)
-        v = -100.0f;
-    return (int16_t)((v >= 0.0f) ? (v + 0.5f) : (v - 0.5f));
+    const uint32_t s = ageMs / 1000UL;
+    return (unsigned)(s > 99UL ? 99UL : s);
+}
+
+// Snapshot Q15 axis -> whole percent, rounded
+static int16_t displayPct(int16_t q)
+{
+    const int32_t v = (int32_t)q * 100;
+    return (int16_t)((v >= 0) ? (v + AXIS_OUT_MAX / 2) / AXIS_OUT_MAX : (v - AXIS_OUT_MAX / 2) / AXIS_OUT_MAX);
 }
 
 static const char *armStateShortName()
@@ -134,6 +140,7 @@ void screenMainLoop(int mode, uint8_t batState)
     char line0[21], line1[21], line2[21], line3[21];
     const char *footerLeftText = nullptr;
     line0[0] = line1[0] = line2[0] = line3[0] = '\0';
+    const InputSnapshot &in = inputSnapshot();
 
     if (splashActive)
     {
@@ -161,31 +168,53 @@ void screenMainLoop(int mode, uint8_t batState)
             }
 
             snprintf(line0, sizeof(line0), "TX:%3u%%      RX:%3u%%", (unsigned)txPctShown, (unsigned)rxPctShown);
-            snprintf(line1, sizeof(line1), "LINK: %s", receiverGetLinkStateShortName());
-            snprintf(line2, sizeof(line2), "ARM : %s", armStateShortName());
-            line3[0] = '\0';
+            const LinkQualityStats lq = linkQualityGet();
+            if (receiverIsLinkEnabled() && lq.valid)
+            {
+                snprintf(line1, sizeof(line1), "LINK: %-4s RX%4u/s", receiverGetLinkStateShortName(), (unsigned)lq.rxPerSec);
+                snprintf(line3, sizeof(line3), "LQ%3u RT%u.%u/%-2u C%3u",
+                         (unsigned)lq.lqPct,
+                         (unsigned)(lq.retriesAvgX10 / 10),
+                         (unsigned)(lq.retriesAvgX10 % 10),
+                         (unsigned)lq.retriesMax,
+                         (unsigned)lq.carrierPct);
+            }
+            else
+            {
+                snprintf(line1, sizeof(line1), "LINK: %s", receiverGetLinkStateShortName());
+                line3[0] = '\0';
+            }
+            if (receiverIsLinkEnabled() && lq.valid && lq.tlmAgeAvgUs > 0)
+            {
+                const unsigned tlmX10 = (unsigned)((lq.tlmAgeAvgUs + 50U) / 100U); // 0.1 ms
+                snprintf(line2, sizeof(line2), "ARM:%-7s T%2u.%ums", armStateShortName(), tlmX10 / 10U, tlmX10 % 10U);
+            }
+            else
+            {
+                snprintf(line2, sizeof(line2), "ARM : %s", armStateShortName());
+            }
             break;
         }
         case 2:
         {
-            snprintf(line2, sizeof(line2), "LX%+5d     RX%+5d", displayPct(joyL.readX()), displayPct(joyR.readX()));
-            snprintf(line3, sizeof(line3), "LY%+5d     RY%+5d", displayPct(joyL.readY()), displayPct(joyR.readY()));
+            snprintf(line2, sizeof(line2), "LX%+5d     RX%+5d", displayPct(in.axis[0]), displayPct(in.axis[2]));
+            snprintf(line3, sizeof(line3), "LY%+5d     RY%+5d", displayPct(in.axis[1]), displayPct(in.axis[3]));
             line0[0] = '\0';
             line1[0] = '\0';
             break;
         }
         case 3:
-            snprintf(line0, sizeof(line0), "XR %4d     YR %4d", joyL.readRawX(), joyL.readRawY());
-            snprintf(line1, sizeof(line1), "XX%+5d     YY%+5d", displayPct(joyL.readLinearX()), displayPct(joyL.readLinearY()));
-            snprintf(line2, sizeof(line2), "X%+6d     Y%+6d", displayPct(joyL.readX()), displayPct(joyL.readY()));
+            snprintf(line0, sizeof(line0), "XR %4d     YR %4d", in.raw[0], in.raw[1]);
+            snprintf(line1, sizeof(line1), "XX%+5d     YY%+5d", displayPct(in.linear[0]), displayPct(in.linear[1]));
+            snprintf(line2, sizeof(line2), "X%+6d     Y%+6d", displayPct(in.axis[0]), displayPct(in.axis[1]));
             line3[0] = '\0';
             footerLeftText = "LJ";
             break;
 
         case 4:
-            snprintf(line0, sizeof(line0), "XR %4d     YR %4d", joyR.readRawX(), joyR.readRawY());
-            snprintf(line1, sizeof(line1), "XX%+5d     YY%+5d", displayPct(joyR.readLinearX()), displayPct(joyR.readLinearY()));
-            snprintf(line2, sizeof(line2), "X%+6d     Y%+6d", displayPct(joyR.readX()), displayPct(joyR.readY()));
+            snprintf(line0, sizeof(line0), "XR %4d     YR %4d", in.raw[2], in.raw[3]);
+            snprintf(line1, sizeof(line1), "XX%+5d     YY%+5d", displayPct(in.linear[2]), displayPct(in.linear[3]));
+            snprintf(line2, sizeof(line2), "X%+6d     Y%+6d", displayPct(in.axis[2]), displayPct(in.axis[3]));
             line3[0] = '\0';
             footerLeftText = "RJ";
             break;
@@ -198,6 +227,28 @@ void screenMainLoop(int mode, uint8_t batState)
             break;
 
         case 6:
+        {
+            uint32_t v = 0, age = 0;
+            if (receiverGetTelemetry(TelemetryId::RxBattMv, v, &age))
+                snprintf(line0, sizeof(line0), "RX BATT %2u.%02uV %2us", (unsigned)(v / 1000UL), (unsigned)((v % 1000UL) / 10UL), telemetryAgeS(age));
+            else
+                snprintf(line0, sizeof(line0), "RX BATT    --");
+            if (receiverGetTelemetry(TelemetryId::RxLoopHz, v, &age))
+                snprintf(line1, sizeof(line1), "RX LOOP %5luHz %2us", (unsigned long)v, telemetryAgeS(age));
+            else
+                snprintf(line1, sizeof(line1), "RX LOOP    --");
+            if (receiverGetTelemetry(TelemetryId::RxRssi, v, &age))
+                snprintf(line2, sizeof(line2), "RX RSSI %4u%%  %2us", (unsigned)v, telemetryAgeS(age));
+            else
+                snprintf(line2, sizeof(line2), "RX RSSI    --");
+            if (receiverGetTelemetry(TelemetryId::RxFrameRate, v, &age))
+                snprintf(line3, sizeof(line3), "RX FPS  %5lu/s %2us", (unsigned long)v, telemetryAgeS(age));
+            else
+                snprintf(line3, sizeof(line3), "RX FPS     --");
+            break;
+        }
+
+        case 7:
             snprintf(line0, sizeof(line0), " SETTINGS");
             snprintf(line2, sizeof(line2), " PRESS C TO ENTER");
             line1[0] = '\0';
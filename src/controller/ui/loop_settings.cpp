@@ -6,9 +6,9 @@
 #include "common/time_utils.h"
 
 static uint32_t oledTick = 0;
-// 1=CALIB JOYS, 2=JOYS EXPO, 3=LED TEST, 4=PHOTO, 5=IO READINGS
+// 1=CALIB JOYS, 2=JOYS EXPO, 3=LED TEST, 4=PHOTO, 5=IO READINGS, 6=LINK, 7=FAILSAFE, 8=MODEL, 9=GROUP, 10=MIXER
 static uint8_t page = 1;
-static const uint8_t totalPages = 5;
+static const uint8_t totalPages = 10;
 static bool initDone = false;
 static uint8_t prevPage = 1;
 static bool centerArmed = false;
@@ -106,6 +106,26 @@ LoopSettingsResult loopSettingsLoop(int mode, uint8_t batState)
         {
             return LoopSettingsResult::StartIoReadings;
         }
+        else if (page == 6)
+        {
+            return LoopSettingsResult::StartLinkSettings;
+        }
+        else if (page == 7)
+        {
+            return LoopSettingsResult::StartFailsafeSettings;
+        }
+        else if (page == 8)
+        {
+            return LoopSettingsResult::StartModelSettings;
+        }
+        else if (page == 9)
+        {
+            return LoopSettingsResult::StartGroupSettings;
+        }
+        else if (page == 10)
+        {
+            return LoopSettingsResult::StartMixerSettings;
+        }
     }
 
     // UI limiter: max 10 Hz (100 ms), unless pageChanged
@@ -146,6 +166,36 @@ LoopSettingsResult loopSettingsLoop(int mode, uint8_t batState)
         snprintf(line1, sizeof(line1), "   READINGS");
         line2[0] = '\0';
         break;
+
+    case 6:
+        snprintf(line0, sizeof(line0), "   LINK");
+        snprintf(line1, sizeof(line1), "   PROFILE");
+        line2[0] = '\0';
+        break;
+
+    case 7:
+        snprintf(line0, sizeof(line0), "   RX");
+        snprintf(line1, sizeof(line1), "   FAILSAFE");
+        line2[0] = '\0';
+        break;
+
+    case 8:
+        snprintf(line0, sizeof(line0), "   MODEL");
+        snprintf(line1, sizeof(line1), "   BIND");
+        line2[0] = '\0';
+        break;
+
+    case 9:
+        snprintf(line0, sizeof(line0), "   RECEIVERS");
+        snprintf(line1, sizeof(line1), "   GROUP");
+        line2[0] = '\0';
+        break;
+
+    case 10:
+        snprintf(line0, sizeof(line0), "   MODEL");
+        snprintf(line1, sizeof(line1), "   MIXER");
+        line2[0] = '\0';
+        break;
     }
 
     uiRenderPage(line0, line1, line2, line3, true, page, totalPages, buttonsLastReleaseKey(), pageChanged, nullptr);
@@ -9,6 +9,11 @@
 #include "controller/ui/settings_pages/led_test.h"
 #include "controller/ui/settings_pages/set_photo.h"
 #include "controller/ui/settings_pages/io_readings.h"
+#include "controller/ui/settings_pages/set_link.h"
+#include "controller/ui/settings_pages/set_failsafe.h"
+#include "controller/ui/settings_pages/set_model.h"
+#include "controller/ui/settings_pages/set_group.h"
+#include "controller/ui/settings_pages/set_mixer.h"
 #include "controller/config.h"
 #include "common/time_utils.h"
 
@@ -20,7 +25,12 @@ enum class UiMode
     Expo,
     LedTest,
     PhotoSettings,
-    IoReadings
+    IoReadings,
+    LinkSettings,
+    FailsafeSettings,
+    ModelSettings,
+    GroupSettings,
+    MixerSettings
 };
 
 static UiMode uiMode = UiMode::Main;
@@ -125,6 +135,36 @@ bool menuLoop(int mode, uint8_t batState)
             uiMode = UiMode::IoReadings;
             return false;
         }
+        if (r == LoopSettingsResult::StartLinkSettings)
+        {
+            setLinkStart();
+            uiMode = UiMode::LinkSettings;
+            return false;
+        }
+        if (r == LoopSettingsResult::StartFailsafeSettings)
+        {
+            setFailsafeStart();
+            uiMode = UiMode::FailsafeSettings;
+            return false;
+        }
+        if (r == LoopSettingsResult::StartModelSettings)
+        {
+            setModelStart();
+            uiMode = UiMode::ModelSettings;
+            return false;
+        }
+        if (r == LoopSettingsResult::StartGroupSettings)
+        {
+            setGroupStart();
+            uiMode = UiMode::GroupSettings;
+            return false;
+        }
+        if (r == LoopSettingsResult::StartMixerSettings)
+        {
+            setMixerStart();
+            uiMode = UiMode::MixerSettings;
+            return false;
+        }
         if (r == LoopSettingsResult::ExitToMain)
         {
             uiMode = UiMode::Main;
@@ -195,6 +235,61 @@ bool menuLoop(int mode, uint8_t batState)
         }
         return false;
     }
+
+    case UiMode::LinkSettings:
+    {
+        LinkSettingsResult lr = setLinkLoop();
+        if (lr == LinkSettingsResult::ExitToSettings)
+        {
+            loopSettingsStart(6);
+            uiMode = UiMode::Settings;
+        }
+        return false;
+    }
+
+    case UiMode::FailsafeSettings:
+    {
+        FailsafeSettingsResult fr = setFailsafeLoop();
+        if (fr == FailsafeSettingsResult::ExitToSettings)
+        {
+            loopSettingsStart(7);
+            uiMode = UiMode::Settings;
+        }
+        return false;
+    }
+
+    case UiMode::ModelSettings:
+    {
+        ModelSettingsResult mr = setModelLoop();
+        if (mr == ModelSettingsResult::ExitToSettings)
+        {
+            loopSettingsStart(8);
+            uiMode = UiMode::Settings;
+        }
+        return false;
+    }
+
+    case UiMode::GroupSettings:
+    {
+        GroupSettingsResult gr = setGroupLoop();
+        if (gr == GroupSettingsResult::ExitToSettings)
+        {
+            loopSettingsStart(9);
+            uiMode = UiMode::Settings;
+        }
+        return false;
+    }
+
+    case UiMode::MixerSettings:
+    {
+        MixerSettingsResult mr = setMixerLoop();
+        if (mr == MixerSettingsResult::ExitToSettings)
+        {
+            loopSettingsStart(10);
+            uiMode = UiMode::Settings;
+        }
+        return false;
+    }
     }
 
     return false;
@@ -4,6 +4,7 @@
 #include "controller/display.h"
 #include "controller/buttons.h"
 #include "controller/joysticks.h"
+#include "controller/input_snapshot.h"
 #include "controller/config.h"
 #include "common/time_utils.h"
 
@@ -58,6 +59,12 @@ static Joystick &stickRef(CalStick s)
     return (s == CalStick::Left) ? joyL : joyR;
 }
 
+// Snapshot index of the stick's X axis (Y follows)
+static uint8_t stickAxisBase(CalStick s)
+{
+    return (s == CalStick::Left) ? 0 : 2;
+}
+
 static bool &extentsFlag(CalStick s)
 {
     return (s == CalStick::Left) ? extentsStartedL : extentsStartedR;
@@ -143,8 +150,10 @@ static void render(bool forceRedraw)
     if (!storedView && curSel == CalSel::Center)
     {
         // update both channels only in CTR mode
-        lastCtrX = j.readRawInvertedX();
-        lastCtrY = j.readRawInvertedY();
+        const InputSnapshot &in = inputSnapshot();
+        const uint8_t base = stickAxisBase(curStick);
+        lastCtrX = j.applyInvert(in.raw[base], true);
+        lastCtrY = j.applyInvert(in.raw[base + 1], false);
         dispCtrX = lastCtrX;
         dispCtrY = lastCtrY;
     }
@@ -207,7 +216,9 @@ CalibrationResult calibJoyLoop()
 
     if (!storedView && curSel == CalSel::Extents)
     {
-        stickRef(curStick).updateCalibrationSample();
+        const InputSnapshot &in = inputSnapshot();
+        const uint8_t base = stickAxisBase(curStick);
+        stickRef(curStick).updateCalibrationSample(in.raw[base], in.raw[base + 1]);
     }
 
     if (input.back)
@@ -250,8 +261,10 @@ CalibrationResult calibJoyLoop()
         }
         else // Center
         {
-            int cx = j.readRawInvertedX();
-            int cy = j.readRawInvertedY();
+            const InputSnapshot &in = inputSnapshot();
+            const uint8_t base = stickAxisBase(curStick);
+            int cx = j.applyInvert(in.raw[base], true);
+            int cy = j.applyInvert(in.raw[base + 1], false);
             j.setCenter(cx, cy);
             lastCtrX = cx;
             lastCtrY = cy;
@@ -3,6 +3,7 @@
 #include "controller/ui/menu.h"
 #include "controller/buttons.h"
 #include "controller/config.h"
+#include "controller/adc_sampler.h"
 #include "common/time_utils.h"
 
 namespace
@@ -19,16 +20,16 @@ void render(bool forceRedraw)
     switch (subPage)
     {
     case 1:
-        snprintf(line0, sizeof(line0), "CH0 RY %4d", analogRead(HW_JOY_R_PIN_Y));
-        snprintf(line1, sizeof(line1), "CH1 RX %4d", analogRead(HW_JOY_R_PIN_X));
-        snprintf(line2, sizeof(line2), "CH3 LY %4d", analogRead(HW_JOY_L_PIN_Y));
-        snprintf(line3, sizeof(line3), "CH4 LX %4d", analogRead(HW_JOY_L_PIN_X));
+        snprintf(line0, sizeof(line0), "CH0 RY %4d", adcSamplerRaw(HW_JOY_R_PIN_Y));
+        snprintf(line1, sizeof(line1), "CH1 RX %4d", adcSamplerRaw(HW_JOY_R_PIN_X));
+        snprintf(line2, sizeof(line2), "CH3 LY %4d", adcSamplerRaw(HW_JOY_L_PIN_Y));
+        snprintf(line3, sizeof(line3), "CH4 LX %4d", adcSamplerRaw(HW_JOY_L_PIN_X));
         footerLeft = "IO RAW";
         break;
 
     case 2:
-        snprintf(line0, sizeof(line0), "CH7 PH %4d", analogRead(HW_PHOTO_PIN));
-        snprintf(line1, sizeof(line1), "CH8 BT %4d", analogRead(HW_BATTERY_PIN));
+        snprintf(line0, sizeof(line0), "CH7 PH %4d", adcSamplerRaw(HW_PHOTO_PIN));
+        snprintf(line1, sizeof(line1), "CH8 BT %4d", adcSamplerRaw(HW_BATTERY_PIN));
         line2[0] = '\0';
         line3[0] = '\0';
         footerLeft = "IO RAW";
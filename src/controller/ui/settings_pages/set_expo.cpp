@@ -1,6 +1,5 @@
 #include <Arduino.h>
 #include <math.h>
-#include <U8g2lib.h>
 
 #include "controller/ui/settings_pages/set_expo.h"
 #include "controller/ui/menu.h"
@@ -18,6 +17,7 @@ struct AxisTuneState
     float expo = 0.0f;
     int deadzone = 0;
     int limit = 100;
+    InputFilterConfig filter{InputFilterType::Off, 1};
 };
 
 static AxisTuneState currentState[4];
@@ -30,6 +30,7 @@ enum class ExpoItem : uint8_t
     Expo = 0,
     Deadzone,
     Limit,
+    Filter,
     View,
     Count
 };
@@ -95,6 +96,47 @@ static const char *axisLabel(uint8_t idx)
     }
 }
 
+// Filter presets in one list: Off, then every type at strength 1..MAX
+static const uint8_t kFilterPresetCount = 1 + ((uint8_t)InputFilterType::Count - 1) * INPUT_FILTER_STRENGTH_MAX;
+
+static uint8_t filterToPreset(const InputFilterConfig &f)
+{
+    if (f.type == InputFilterType::Off || (uint8_t)f.type >= (uint8_t)InputFilterType::Count)
+        return 0;
+    return (uint8_t)(1 + ((uint8_t)f.type - 1) * INPUT_FILTER_STRENGTH_MAX + (f.strength - 1));
+}
+
+static InputFilterConfig presetToFilter(int preset)
+{
+    preset = constrain(preset, 0, (int)kFilterPresetCount - 1);
+    if (preset == 0)
+        return InputFilterConfig{InputFilterType::Off, 1};
+    return InputFilterConfig{(InputFilterType)(1 + (preset - 1) / INPUT_FILTER_STRENGTH_MAX),
+                             (uint8_t)(1 + (preset - 1) % INPUT_FILTER_STRENGTH_MAX)};
+}
+
+static void formatFilterShort(char *dst, size_t dstSize, const InputFilterConfig &f)
+{
+    switch (f.type)
+    {
+    case InputFilterType::Ema:
+        snprintf(dst, dstSize, "EM%u", f.strength);
+        break;
+    case InputFilterType::Median:
+        snprintf(dst, dstSize, "MD%u", f.strength);
+        break;
+    case InputFilterType::Biquad:
+        snprintf(dst, dstSize, "BQ%u", f.strength);
+        break;
+    case InputFilterType::OneEuro:
+        snprintf(dst, dstSize, "1E%u", f.strength);
+        break;
+    default:
+        snprintf(dst, dstSize, "--");
+        break;
+    }
+}
+
 static void formatLimitShort(char *dst, size_t dstSize, int pct)
 {
     pct = clampLimitLocal(pct);
@@ -110,6 +152,7 @@ static AxisTuneState readAxisTuneState(uint8_t axis)
     state.expo = joysticksGetExpoAxis(axis);
     state.deadzone = joysticksGetDeadzoneAxis(axis);
     state.limit = joysticksGetLimitAxis(axis);
+    state.filter = joysticksGetFilterAxis(axis);
     return state;
 }
 
@@ -118,6 +161,7 @@ static void writeAxisTuneState(uint8_t axis, const AxisTuneState &state)
     joysticksSetExpoAxis(axis, clampExpoLocal(state.expo));
     joysticksSetDeadzoneAxis(axis, state.deadzone);
     joysticksSetLimitAxis(axis, state.limit);
+    joysticksSetFilterAxis(axis, state.filter);
 }
 
 static void restoreOriginalState()
@@ -126,14 +170,15 @@ static void restoreOriginalState()
         writeAxisTuneState(i, originalState[i]);
 }
 
-static void overlayExpo(U8G2 &oled, void *)
+static void overlayExpo(DisplayCanvas &oled, void *)
 {
     const int W = 128;
     const int topPad = 0;
     const int bottomPad = 12;
     const int H = 64 - topPad - bottomPad;
 
-    auto pctFor = [](float expo, float xNorm, float deadzoneNorm) -> float
+    // Old view only: the live table holds the current (New) settings
+    auto pctFor = [](float expo, float xNorm, float deadzoneNorm, int limit) -> float
     {
         if (xNorm < deadzoneNorm)
             return 0.0f;
@@ -141,7 +186,7 @@ static void overlayExpo(U8G2 &oled, void *)
         norm = constrain(norm, 0.0f, 1.0f);
         float curved = pow(norm, 1.0f + expo);
         curved = constrain(curved, 0.0f, 1.0f);
-        return curved * 100.0f;
+        return curved * (float)clampLimitLocal(limit);
     };
 
     float dzNorm = (float)currentState[axisIdx].deadzone / (float)ADC_CENTER;
@@ -173,6 +218,7 @@ static void overlayExpo(U8G2 &oled, void *)
         (!curveValid) ||
         (fabsf(expoShown - lastExpo) > EXPO_EPS) ||
         (fabsf(dzNorm - lastDz) > DZ_EPS) ||
+        (limitShown != lastLimit) ||
         (axisIdx != lastAxis) ||
         (viewMode != lastView);
 
@@ -187,12 +233,15 @@ static void overlayExpo(U8G2 &oled, void *)
         for (int x = 0; x < W; ++x)
         {
             float xNorm = (float)x / (float)(W - 1);
-            int y = yFromPct(pctFor(expoShown, xNorm, dzNorm));
+            float pct = (viewMode == ViewMode::New) ? joysticksCurvePct(axisIdx, xNorm)
+                                                    : pctFor(expoShown, xNorm, dzNorm, limitShown);
+            int y = yFromPct(pct);
             yCache[x] = (uint8_t)constrain(y, 0, 63);
         }
 
         lastExpo = expoShown;
         lastDz = dzNorm;
+        lastLimit = limitShown;
         lastAxis = axisIdx;
         lastView = viewMode;
         curveValid = true;
@@ -255,8 +304,11 @@ static void overlayExpo(U8G2 &oled, void *)
     const char markExpo = (selected == ExpoItem::Expo) ? '>' : ' ';
     const char markDz = (selected == ExpoItem::Deadzone) ? '>' : ' ';
     const char markLim = (selected == ExpoItem::Limit) ? '>' : ' ';
+    const char markFlt = (selected == ExpoItem::Filter) ? '>' : ' ';
     char limCur[4];
     char limOrig[4];
+    char fltCur[4];
+    char fltOrig[4];
 
     int cur100 = (int)(currentState[axisIdx].expo * 100.0f + 0.5f);
     int orig100 = (int)(originalState[axisIdx].expo * 100.0f + 0.5f);
@@ -276,6 +328,14 @@ static void overlayExpo(U8G2 &oled, void *)
     snprintf(buf, sizeof(buf), "%clim: %2s/%2s", markLim, limCur, limOrig);
     oled.drawStr(0, 34, buf);
 
+    // Filter with the delay it adds at the current tick rate
+    const uint32_t delayUs = joysticksGetFilterDelayUs(axisIdx);
+    formatFilterShort(fltCur, sizeof(fltCur), currentState[axisIdx].filter);
+    formatFilterShort(fltOrig, sizeof(fltOrig), originalState[axisIdx].filter);
+    snprintf(buf, sizeof(buf), "%cflt:%3s/%-3s%3lu.%01lums", markFlt, fltCur, fltOrig,
+             (unsigned long)(delayUs / 1000), (unsigned long)((delayUs % 1000) / 100));
+    oled.drawStr(0, 46, buf);
+
     oled.setFontMode(1); // restore transparent mode (optional)
 }
 
@@ -441,6 +501,22 @@ ExpoResult setExpoLoop()
         changed = true;
     }
 
+    if (selected == ExpoItem::Filter && (input.inc || input.dec || input.incFast || input.decFast))
+    {
+        // Fast steps jump between filter types
+        int preset = filterToPreset(currentState[axisIdx].filter);
+        if (input.inc)
+            preset += 1;
+        else if (input.dec)
+            preset -= 1;
+        else if (input.incFast)
+            preset += INPUT_FILTER_STRENGTH_MAX;
+        else
+            preset -= INPUT_FILTER_STRENGTH_MAX;
+        currentState[axisIdx].filter = presetToFilter(preset);
+        changed = true;
+    }
+
     if (selected == ExpoItem::View && (input.inc || input.dec || input.incFast || input.decFast))
     {
         viewMode = (viewMode == ViewMode::New) ? ViewMode::Old : ViewMode::New;
@@ -469,6 +545,7 @@ ExpoResult setExpoLoop()
         joysticksSaveExpoAxis(axisIdx);
         joysticksSaveDeadzone();
         joysticksSaveLimit();
+        joysticksSaveFilter();
         originalState[axisIdx] = currentState[axisIdx];
         viewMode = ViewMode::New;
         saveUntilMs = millis() + 1200;
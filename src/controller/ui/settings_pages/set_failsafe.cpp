@@ -0,0 +1,188 @@
+#include <Arduino.h>
+#include "controller/ui/settings_pages/set_failsafe.h"
+#include "controller/ui/menu.h"
+#include "controller/ui/ui_input.h"
+#include "controller/receiver.h"
+#include "controller/buttons.h"
+#include "controller/config.h"
+#include "common/comm.h"
+#include "common/time_utils.h"
+
+namespace
+{
+enum class FsItem : uint8_t
+{
+    Mode = 0,
+    Value,
+    Missed,
+    Count
+};
+
+uint32_t oledTick = 0;
+uint32_t saveUntilMs = 0;
+uint8_t channel = 0;
+FsItem selected = FsItem::Mode;
+CommFailsafeConfig currentCfg{};
+
+const char *channelLabel(uint8_t ch, char *buf, size_t size)
+{
+    static const char *const kNames[COMM_CH_DEFAULT_COUNT] = {"LX", "LY", "RX", "RY", "JL", "JR", "F1", "F2"};
+    if (ch < COMM_CH_DEFAULT_COUNT)
+        return kNames[ch];
+    snprintf(buf, size, "CH%u", (unsigned)(ch + 1));
+    return buf;
+}
+
+const char *modeLabel(CommFailsafeMode mode)
+{
+    switch (mode)
+    {
+    case CommFailsafeMode::Preset:
+        return "PRESET";
+    case CommFailsafeMode::Cut:
+        return "CUT";
+    case CommFailsafeMode::Hold:
+    default:
+        return "HOLD";
+    }
+}
+
+void render(bool forceRedraw)
+{
+    char line0[21], line1[21], line2[21], line3[21];
+    char footerLeft[14];
+    char chBuf[6];
+
+    const char mode = (selected == FsItem::Mode) ? '>' : ' ';
+    const char val = (selected == FsItem::Value) ? '>' : ' ';
+    const char missed = (selected == FsItem::Missed) ? '>' : ' ';
+    const uint32_t periodUs = commGetLinkProfileInfo(receiverGetLinkProfile()).txPeriodUs;
+    const uint32_t detectMs = (periodUs * currentCfg.missedPeriods + periodUs / 2UL + 500UL) / 1000UL;
+
+    snprintf(line0, sizeof(line0), "CH    %s", channelLabel(channel, chBuf, sizeof(chBuf)));
+    snprintf(line1, sizeof(line1), "MODE %c%s", mode, modeLabel(currentCfg.mode[channel]));
+    if (currentCfg.mode[channel] == CommFailsafeMode::Preset)
+        snprintf(line2, sizeof(line2), "VAL  %c%+4d%%", val, (int)commChannelToPct(currentCfg.value[channel]));
+    else
+        snprintf(line2, sizeof(line2), "VAL  %c --", val);
+    snprintf(line3, sizeof(line3), "LOSS %c%3u fr %4lums", missed, (unsigned)currentCfg.missedPeriods, (unsigned long)detectMs);
+
+    const bool showSave = millis() < saveUntilMs;
+    snprintf(footerLeft, sizeof(footerLeft), "%s", showSave ? "FS SAVE" : "FAILSAFE");
+
+    uiRenderPage(line0,
+                 line1,
+                 line2,
+                 line3,
+                 true,
+                 (uint8_t)(channel + 1),
+                 currentCfg.channelCount,
+                 buttonsLastReleaseKey(),
+                 forceRedraw,
+                 footerLeft);
+}
+
+void applyDelta(int delta)
+{
+    switch (selected)
+    {
+    case FsItem::Mode:
+    {
+        const int count = (int)CommFailsafeMode::Count;
+        const int step = (delta < 0) ? -1 : 1;
+        currentCfg.mode[channel] = (CommFailsafeMode)(((int)currentCfg.mode[channel] + step + count) % count);
+        break;
+    }
+    case FsItem::Value:
+    {
+        if (currentCfg.mode[channel] != CommFailsafeMode::Preset)
+            break;
+        int pct = (int)commChannelToPct(currentCfg.value[channel]) + delta;
+        if (pct < -100)
+            pct = -100;
+        if (pct > 100)
+            pct = 100;
+        currentCfg.value[channel] = (uint16_t)(COMM_CH_CENTER + (pct * COMM_CH_SPAN) / 100);
+        break;
+    }
+    case FsItem::Missed:
+    {
+        int next = (int)currentCfg.missedPeriods + delta;
+        if (next < 1)
+            next = 1;
+        if (next > 255)
+            next = 255;
+        currentCfg.missedPeriods = (uint8_t)next;
+        break;
+    }
+    default:
+        break;
+    }
+    saveUntilMs = 0;
+}
+} // namespace
+
+void setFailsafeStart()
+{
+    uiInputReset();
+    oledTick = 0;
+    saveUntilMs = 0;
+    channel = 0;
+    selected = FsItem::Mode;
+    currentCfg = receiverGetFailsafeConfig();
+    render(true);
+}
+
+FailsafeSettingsResult setFailsafeLoop()
+{
+    const UiInputActions input = uiInputPoll();
+
+    if (input.selectNext)
+    {
+        selected = (FsItem)(((uint8_t)selected + 1) % (uint8_t)FsItem::Count);
+        render(true);
+        return FailsafeSettingsResult::Stay;
+    }
+
+    if (input.pagePrev || input.pageNext)
+    {
+        const uint8_t count = currentCfg.channelCount;
+        channel = (uint8_t)((channel + (input.pageNext ? 1 : count - 1)) % count);
+        render(true);
+        return FailsafeSettingsResult::Stay;
+    }
+
+    if (input.dec || input.decFast)
+    {
+        applyDelta(input.decFast ? -10 : -1);
+        render(true);
+        return FailsafeSettingsResult::Stay;
+    }
+    if (input.inc || input.incFast)
+    {
+        applyDelta(input.incFast ? 10 : 1);
+        render(true);
+        return FailsafeSettingsResult::Stay;
+    }
+
+    // CENTER: push to the receiver and store
+    if (input.enter)
+    {
+        receiverSetFailsafeConfig(currentCfg);
+        receiverSaveFailsafeConfig();
+        currentCfg = receiverGetFailsafeConfig();
+        saveUntilMs = millis() + 1200;
+        render(true);
+        return FailsafeSettingsResult::Stay;
+    }
+
+    // DOWN: leave, unsaved edits are dropped
+    if (input.back)
+        return FailsafeSettingsResult::ExitToSettings;
+
+    if (!everyMs(DISPLAY_UI_REFRESH_INTERVAL_MS, oledTick))
+        return FailsafeSettingsResult::Stay;
+
+    render(false);
+    return FailsafeSettingsResult::Stay;
+}
@@ -0,0 +1,122 @@
+#include <Arduino.h>
+#include "controller/ui/settings_pages/set_group.h"
+#include "controller/ui/menu.h"
+#include "controller/ui/ui_input.h"
+#include "controller/models.h"
+#include "controller/receiver.h"
+#include "controller/buttons.h"
+#include "controller/config.h"
+#include "common/time_utils.h"
+
+namespace
+{
+uint32_t oledTick = 0;
+uint8_t model = 0;
+bool rejected = false; // last F2 could not add the model
+
+// Time slot of the model, or COMM_MAX_SLOTS when it is not on air
+uint8_t slotOf(uint8_t modelId)
+{
+    for (uint8_t i = 0; i < receiverGetSlotCount(); ++i)
+    {
+        if (receiverGetSlotModel(i) == modelId)
+            return i;
+    }
+    return COMM_MAX_SLOTS;
+}
+
+void render(bool forceRedraw)
+{
+    char line0[21], line1[21], line2[21], line3[21];
+    char footerLeft[14];
+
+    const bool driven = (model == modelsGetActive());
+    const uint8_t slot = slotOf(model);
+    const uint8_t count = receiverGetSlotCount();
+    snprintf(line0, sizeof(line0), "RX GROUP >M%u%s", (unsigned)(model + 1), driven ? " *" : "");
+
+    if (!modelsIsBound(model) && !driven)
+        snprintf(line1, sizeof(line1), "NOT BOUND");
+    else if (slot < COMM_MAX_SLOTS)
+        snprintf(line1, sizeof(line1), "SLOT %u/%u %s", (unsigned)(slot + 1), (unsigned)count, driven ? "DRIVEN" : "HOLD");
+    else
+        snprintf(line1, sizeof(line1), "%s", rejected ? "GROUP FULL" : "NOT IN GROUP");
+
+    line2[0] = '\0';
+    if (slot < COMM_MAX_SLOTS)
+    {
+        uint32_t pct = 0;
+        if (receiverGetSlotTelemetry(slot, TelemetryId::RxBattPct, pct))
+            snprintf(line2, sizeof(line2), "RX    %-4s BAT%3u%%",
+                     receiverGetLinkStateShortName(receiverGetSlotLinkState(slot)), (unsigned)pct);
+        else
+            snprintf(line2, sizeof(line2), "RX    %s",
+                     receiverGetLinkStateShortName(receiverGetSlotLinkState(slot)));
+    }
+
+    // Every receiver in the group gets the profile rate divided by the slot count
+    const CommLinkProfileInfo &p = commGetLinkProfileInfo(receiverGetLinkProfile());
+    snprintf(line3, sizeof(line3), "RATE  %u Hz/RX", (unsigned)(p.rateHz / (count ? count : 1)));
+
+    snprintf(footerLeft, sizeof(footerLeft), "C:DRIVE F2:GRP");
+
+    uiRenderPage(line0,
+                 line1,
+                 line2,
+                 line3,
+                 true,
+                 (uint8_t)(model + 1),
+                 MODEL_COUNT,
+                 buttonsLastReleaseKey(),
+                 forceRedraw,
+                 footerLeft);
+}
+} // namespace
+
+void setGroupStart()
+{
+    uiInputReset();
+    oledTick = 0;
+    model = modelsGetActive();
+    rejected = false;
+    render(true);
+}
+
+GroupSettingsResult setGroupLoop()
+{
+    const UiInputActions input = uiInputPoll();
+
+    if (input.pagePrev || input.pageNext)
+    {
+        model = (uint8_t)((model + (input.pageNext ? 1 : MODEL_COUNT - 1)) % MODEL_COUNT);
+        rejected = false;
+        render(true);
+        return GroupSettingsResult::Stay;
+    }
+
+    // F2: add to / remove from the group (the driven model always stays on air)
+    if (input.inc)
+    {
+        rejected = !modelsSetInGroup(model, !modelsInGroup(model));
+        render(true);
+        return GroupSettingsResult::Stay;
+    }
+
+    // CENTER: sticks drive this receiver, the previous one holds its last frame
+    if (input.enter && (modelsIsBound(model) || model == modelsGetActive()))
+    {
+        modelsSelect(model);
+        render(true);
+        return GroupSettingsResult::Stay;
+    }
+
+    // DOWN: leave
+    if (input.back)
+        return GroupSettingsResult::ExitToSettings;
+
+    if (!everyMs(DISPLAY_UI_REFRESH_INTERVAL_MS, oledTick))
+        return GroupSettingsResult::Stay;
+
+    render(false);
+    return GroupSettingsResult::Stay;
+}
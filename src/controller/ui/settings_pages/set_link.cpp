@@ -0,0 +1,114 @@
+#include <Arduino.h>
+#include "controller/ui/settings_pages/set_link.h"
+#include "controller/ui/menu.h"
+#include "controller/ui/ui_input.h"
+#include "controller/receiver.h"
+#include "controller/buttons.h"
+#include "controller/config.h"
+#include "common/comm.h"
+#include "common/time_utils.h"
+
+namespace
+{
+uint32_t oledTick = 0;
+uint32_t saveUntilMs = 0;
+CommLinkProfile selectedProfile = CommLinkProfile::Robust50;
+
+const char *dataRateLabel(uint8_t dataRate)
+{
+    switch (dataRate)
+    {
+    case 0: // RF24_1MBPS
+        return "1 Mbps";
+    case 1: // RF24_2MBPS
+        return "2 Mbps";
+    case 2: // RF24_250KBPS
+    default:
+        return "250 kbps";
+    }
+}
+
+void render(bool forceRedraw)
+{
+    char line0[21], line1[21], line2[21], line3[21];
+    char footerLeft[14];
+
+    const CommLinkProfileInfo &p = commGetLinkProfileInfo(selectedProfile);
+    const bool active = (selectedProfile == receiverGetLinkProfile());
+
+    snprintf(line0, sizeof(line0), "PROF  >%s%s", p.name, active ? " *" : "");
+    snprintf(line1, sizeof(line1), "RATE  %u Hz", (unsigned)p.rateHz);
+    snprintf(line2, sizeof(line2), "AIR   %s", dataRateLabel(p.dataRate));
+    snprintf(line3, sizeof(line3), "RETRY %ux %uus",
+             (unsigned)p.retryCount,
+             (unsigned)((p.retryDelay + 1U) * 250U));
+
+    const bool showSave = millis() < saveUntilMs;
+    snprintf(footerLeft, sizeof(footerLeft), "%s", showSave ? "LINK SAVE" : "LINK");
+
+    uiRenderPage(line0,
+                 line1,
+                 line2,
+                 line3,
+                 true,
+                 (uint8_t)selectedProfile + 1,
+                 (uint8_t)CommLinkProfile::Count,
+                 buttonsLastReleaseKey(),
+                 forceRedraw,
+                 footerLeft);
+}
+
+void stepProfile(int delta)
+{
+    const int count = (int)CommLinkProfile::Count;
+    int next = ((int)selectedProfile + delta + count) % count;
+    selectedProfile = (CommLinkProfile)next;
+    saveUntilMs = 0;
+}
+} // namespace
+
+void setLinkStart()
+{
+    uiInputReset();
+    oledTick = 0;
+    saveUntilMs = 0;
+    selectedProfile = receiverGetLinkProfile();
+    render(true);
+}
+
+LinkSettingsResult setLinkLoop()
+{
+    const UiInputActions input = uiInputPoll();
+
+    if (input.dec || input.decFast || input.pagePrev)
+    {
+        stepProfile(-1);
+        render(true);
+        return LinkSettingsResult::Stay;
+    }
+    if (input.inc || input.incFast || input.pageNext)
+    {
+        stepProfile(1);
+        render(true);
+        return LinkSettingsResult::Stay;
+    }
+
+    // CENTER: apply to radio and store; the receiver scans to the new profile
+    if (input.enter)
+    {
+        receiverSetLinkProfile(selectedProfile);
+        receiverSaveLinkProfile();
+        saveUntilMs = millis() + 1200;
+        render(true);
+        return LinkSettingsResult::Stay;
+    }
+
+    if (input.back)
+        return LinkSettingsResult::ExitToSettings;
+
+    if (!everyMs(DISPLAY_UI_REFRESH_INTERVAL_MS, oledTick))
+        return LinkSettingsResult::Stay;
+
+    render(false);
+    return LinkSettingsResult::Stay;
+}
@@ -0,0 +1,218 @@
+#include <Arduino.h>
+#include "controller/ui/settings_pages/set_mixer.h"
+#include "controller/ui/menu.h"
+#include "controller/ui/ui_input.h"
+#include "controller/mixer.h"
+#include "controller/buttons.h"
+#include "controller/config.h"
+#include "common/time_utils.h"
+
+namespace
+{
+enum class MixItem : uint8_t
+{
+    Output = 0,
+    Source,
+    Trim,
+    Weight,
+    Offset,
+    Curve,
+    Condition,
+    Op,
+    Subtrim,
+    Count
+};
+
+uint32_t oledTick = 0;
+uint32_t saveUntilMs = 0;
+uint8_t lineIdx = 0;
+MixItem selected = MixItem::Output;
+MixerConfig currentCfg{};
+
+const char *sourceLabel(MixSource s)
+{
+    static const char *const kNames[(uint8_t)MixSource::Count] = {"--", "LX", "LY", "RX", "RY", "JL", "JR", "F1", "F2", "MAX"};
+    return ((uint8_t)s < (uint8_t)MixSource::Count) ? kNames[(uint8_t)s] : "??";
+}
+
+const char *curveLabel(MixCurve c)
+{
+    static const char *const kNames[(uint8_t)MixCurve::Count] = {"LIN", "POS", "NEG", "ABS"};
+    return ((uint8_t)c < (uint8_t)MixCurve::Count) ? kNames[(uint8_t)c] : "???";
+}
+
+const char *conditionLabel(MixCondition c)
+{
+    static const char *const kNames[(uint8_t)MixCondition::Count] = {"ALW", "JL+", "JL-", "JR+", "JR-", "F1+", "F1-", "F2+", "F2-"};
+    return ((uint8_t)c < (uint8_t)MixCondition::Count) ? kNames[(uint8_t)c] : "???";
+}
+
+bool isStickSource(MixSource s)
+{
+    return s >= MixSource::LX && s <= MixSource::RY;
+}
+
+char mark(MixItem item)
+{
+    return (selected == item) ? '>' : ' ';
+}
+
+void render(bool forceRedraw)
+{
+    char line0[21], line1[21], line2[21], line3[21];
+    char footerLeft[14];
+    char trimBuf[5];
+
+    const MixLine &l = currentCfg.line[lineIdx];
+    if (isStickSource(l.source))
+        snprintf(trimBuf, sizeof(trimBuf), "%+3d", (int)currentCfg.trim[(uint8_t)l.source - (uint8_t)MixSource::LX]);
+    else
+        snprintf(trimBuf, sizeof(trimBuf), " --");
+
+    snprintf(line0, sizeof(line0), "%cCH%-2u %c%-3s %cTRM%s", mark(MixItem::Output), (unsigned)(l.output + 1),
+             mark(MixItem::Source), sourceLabel(l.source), mark(MixItem::Trim), trimBuf);
+    snprintf(line1, sizeof(line1), "%cWGT%+4d %cOFS%+4d", mark(MixItem::Weight), (int)l.weight,
+             mark(MixItem::Offset), (int)l.offset);
+    snprintf(line2, sizeof(line2), "%cCRV %s %cIF %s", mark(MixItem::Curve), curveLabel(l.curve),
+             mark(MixItem::Condition), conditionLabel(l.condition));
+    snprintf(line3, sizeof(line3), "%cOP %s %cSUB%+4d", mark(MixItem::Op), (l.op == MixOp::Replace) ? "SET" : "ADD",
+             mark(MixItem::Subtrim), (int)currentCfg.subtrim[l.output]);
+
+    const bool showSave = millis() < saveUntilMs;
+    snprintf(footerLeft, sizeof(footerLeft), "%s", showSave ? "MIX SAVE" : "MIXER");
+
+    uiRenderPage(line0,
+                 line1,
+                 line2,
+                 line3,
+                 true,
+                 (uint8_t)(lineIdx + 1),
+                 MIX_LINES_MAX,
+                 buttonsLastReleaseKey(),
+                 forceRedraw,
+                 footerLeft);
+}
+
+template <typename E>
+E stepEnum(E v, int delta)
+{
+    const int count = (int)E::Count;
+    const int step = (delta < 0) ? -1 : 1;
+    return (E)(((int)v + step + count) % count);
+}
+
+void applyDelta(int delta)
+{
+    MixLine &l = currentCfg.line[lineIdx];
+    switch (selected)
+    {
+    case MixItem::Output:
+    {
+        const int step = (delta < 0) ? -1 : 1;
+        l.output = (uint8_t)(((int)l.output + step + COMM_MAX_CHANNELS) % COMM_MAX_CHANNELS);
+        // Channels up to the highest output in use are sent
+        if (l.output >= currentCfg.channelCount)
+            currentCfg.channelCount = (uint8_t)(l.output + 1);
+        break;
+    }
+    case MixItem::Source:
+        l.source = stepEnum(l.source, delta);
+        break;
+    case MixItem::Trim:
+        if (isStickSource(l.source))
+        {
+            int8_t &t = currentCfg.trim[(uint8_t)l.source - (uint8_t)MixSource::LX];
+            t = (int8_t)constrain((int)t + delta, -MIX_TRIM_MAX, MIX_TRIM_MAX);
+        }
+        break;
+    case MixItem::Weight:
+        l.weight = (int8_t)constrain((int)l.weight + delta, -100, 100);
+        break;
+    case MixItem::Offset:
+        l.offset = (int8_t)constrain((int)l.offset + delta, -100, 100);
+        break;
+    case MixItem::Curve:
+        l.curve = stepEnum(l.curve, delta);
+        break;
+    case MixItem::Condition:
+        l.condition = stepEnum(l.condition, delta);
+        break;
+    case MixItem::Op:
+        l.op = stepEnum(l.op, delta);
+        break;
+    case MixItem::Subtrim:
+    {
+        int8_t &st = currentCfg.subtrim[l.output];
+        st = (int8_t)constrain((int)st + delta, -100, 100);
+        break;
+    }
+    default:
+        break;
+    }
+    saveUntilMs = 0;
+}
+} // namespace
+
+void setMixerStart()
+{
+    uiInputReset();
+    oledTick = 0;
+    saveUntilMs = 0;
+    lineIdx = 0;
+    selected = MixItem::Output;
+    currentCfg = mixerGetConfig();
+    render(true);
+}
+
+MixerSettingsResult setMixerLoop()
+{
+    const UiInputActions input = uiInputPoll();
+
+    if (input.selectNext)
+    {
+        selected = (MixItem)(((uint8_t)selected + 1) % (uint8_t)MixItem::Count);
+        render(true);
+        return MixerSettingsResult::Stay;
+    }
+
+    if (input.pagePrev || input.pageNext)
+    {
+        lineIdx = (uint8_t)((lineIdx + (input.pageNext ? 1 : MIX_LINES_MAX - 1)) % MIX_LINES_MAX);
+        render(true);
+        return MixerSettingsResult::Stay;
+    }
+
+    if (input.dec || input.decFast)
+    {
+        applyDelta(input.decFast ? -10 : -1);
+        render(true);
+        return MixerSettingsResult::Stay;
+    }
+    if (input.inc || input.incFast)
+    {
+        applyDelta(input.incFast ? 10 : 1);
+        render(true);
+        return MixerSettingsResult::Stay;
+    }
+
+    // CENTER: compile, go live and store for the active model
+    if (input.enter)
+    {
+        mixerSetConfig(currentCfg);
+        mixerSaveModel();
+        currentCfg = mixerGetConfig();
+        saveUntilMs = millis() + 1200;
+        render(true);
+        return MixerSettingsResult::Stay;
+    }
+
+    // DOWN: leave, unsaved edits are dropped
+    if (input.back)
+        return MixerSettingsResult::ExitToSettings;
+
+    if (!everyMs(DISPLAY_UI_REFRESH_INTERVAL_MS, oledTick))
+        return MixerSettingsResult::Stay;
+
+    render(false);
+    return MixerSettingsResult::Stay;
+}
@@ -0,0 +1,124 @@
+#include <Arduino.h>
+#include "controller/ui/settings_pages/set_model.h"
+#include "controller/ui/menu.h"
+#include "controller/ui/ui_input.h"
+#include "controller/models.h"
+#include "controller/receiver.h"
+#include "controller/buttons.h"
+#include "controller/config.h"
+#include "common/time_utils.h"
+
+namespace
+{
+uint32_t oledTick = 0;
+uint8_t slot = 0;
+
+const char *bindLabel(ModelBindState state)
+{
+    switch (state)
+    {
+    case ModelBindState::Binding:
+        return "BINDING...";
+    case ModelBindState::Done:
+        return "BIND OK";
+    case ModelBindState::Failed:
+        return "BIND FAILED";
+    case ModelBindState::Idle:
+    default:
+        return "";
+    }
+}
+
+void render(bool forceRedraw)
+{
+    char line0[21], line1[21], line2[21], line3[21];
+    char footerLeft[14];
+
+    const bool active = (slot == modelsGetActive());
+    const bool bound = modelsIsBound(slot);
+    snprintf(line0, sizeof(line0), "MODEL >%u%s", (unsigned)(slot + 1), active ? " *" : "");
+
+    if (bound)
+    {
+        uint8_t a[5];
+        modelsGetAddress(slot, a);
+        snprintf(line1, sizeof(line1), "ADDR  %02X%02X%02X%02X%02X", a[0], a[1], a[2], a[3], a[4]);
+    }
+    else
+    {
+        snprintf(line1, sizeof(line1), "ADDR  DEFAULT");
+    }
+
+    uint32_t rxModel = 0;
+    if (active && receiverGetLinkState() == ReceiverLinkState::Connected &&
+        receiverGetTelemetry(TelemetryId::RxModelId, rxModel))
+        snprintf(line2, sizeof(line2), "RX    MODEL %u", (unsigned)(rxModel + 1));
+    else
+        snprintf(line2, sizeof(line2), "RX    %s", receiverGetLinkStateShortName());
+
+    snprintf(line3, sizeof(line3), "%s", bindLabel(modelsBindState()));
+
+    snprintf(footerLeft, sizeof(footerLeft), "C:USE F2:BIND");
+
+    uiRenderPage(line0,
+                 line1,
+                 line2,
+                 line3,
+                 true,
+                 (uint8_t)(slot + 1),
+                 MODEL_COUNT,
+                 buttonsLastReleaseKey(),
+                 forceRedraw,
+                 footerLeft);
+}
+} // namespace
+
+void setModelStart()
+{
+    uiInputReset();
+    oledTick = 0;
+    slot = modelsGetActive();
+    render(true);
+}
+
+ModelSettingsResult setModelLoop()
+{
+    const UiInputActions input = uiInputPoll();
+    const bool binding = (modelsBindState() == ModelBindState::Binding);
+
+    if (!binding && (input.pagePrev || input.pageNext))
+    {
+        slot = (uint8_t)((slot + (input.pageNext ? 1 : MODEL_COUNT - 1)) % MODEL_COUNT);
+        render(true);
+        return ModelSettingsResult::Stay;
+    }
+
+    // F2: bind the receiver next to the controller to this slot
+    if (!binding && input.inc)
+    {
+        modelsBindStart(slot);
+        render(true);
+        return ModelSettingsResult::Stay;
+    }
+
+    // CENTER: use this model
+    if (!binding && input.enter)
+    {
+        modelsSelect(slot);
+        render(true);
+        return ModelSettingsResult::Stay;
+    }
+
+    // DOWN: leave (aborts a running bind)
+    if (input.back)
+    {
+        modelsBindCancel();
+        return ModelSettingsResult::ExitToSettings;
+    }
+
+    if (!everyMs(DISPLAY_UI_REFRESH_INTERVAL_MS, oledTick))
+        return ModelSettingsResult::Stay;
+
+    render(false);
+    return ModelSettingsResult::Stay;
+}
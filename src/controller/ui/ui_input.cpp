@@ -1,56 +1,22 @@
 #include "controller/ui/ui_input.h"
 #include "controller/buttons.h"
+#include "controller/config.h"
 
 namespace
 {
 constexpr uint32_t kFastRepeatMs = 800;
-constexpr uint32_t kFastThresholdMs = 800;
-bool armed[(int)Key::JR + 1] = {};
+uint16_t ignoreMask = 0; // held at reset: their release belongs to the previous screen
+uint32_t lastFastMs[(int)Key::JR + 1] = {};
 
-void flushKey(Key key)
+// Long starts fast stepping, Repeat events continue it every kFastRepeatMs
+bool fastStep(const ButtonEvent &ev)
 {
-    (void)keyReleased(key);
-    (void)keyShortClick(key, 5000, true);
-}
-
-void rearmAll()
-{
-    armed[(int)Key::Left] = !keyDown(Key::Left);
-    armed[(int)Key::Right] = !keyDown(Key::Right);
-    armed[(int)Key::Up] = !keyDown(Key::Up);
-    armed[(int)Key::Down] = !keyDown(Key::Down);
-    armed[(int)Key::Center] = !keyDown(Key::Center);
-    armed[(int)Key::F1] = !keyDown(Key::F1);
-    armed[(int)Key::F2] = !keyDown(Key::F2);
-}
-
-bool consumeRelease(Key key)
-{
-    const int idx = (int)key;
-    if (!armed[idx] && !keyDown(key))
-        armed[idx] = true;
-
-    if (armed[idx] && keyReleased(key))
-    {
-        armed[idx] = false;
-        return true;
-    }
-
-    return false;
-}
-
-bool consumeShort(Key key)
-{
-    const int idx = (int)key;
-    if (!armed[idx] && !keyDown(key))
-        armed[idx] = true;
-
-    if (armed[idx] && keyShortClick(key))
+    const int idx = (int)ev.key;
+    if (ev.type == ButtonEventType::Long || ev.atMs - lastFastMs[idx] >= kFastRepeatMs)
     {
-        armed[idx] = false;
+        lastFastMs[idx] = ev.atMs;
         return true;
     }
-
     return false;
 }
 } // namespace
@@ -58,29 +24,61 @@ bool consumeShort(Key key)
 void uiInputReset()
 {
     buttonsConsumeAll();
-    flushKey(Key::Left);
-    flushKey(Key::Right);
-    flushKey(Key::Up);
-    flushKey(Key::Down);
-    flushKey(Key::Center);
-    flushKey(Key::F1);
-    flushKey(Key::F2);
-    rearmAll();
+    ignoreMask = buttonsDownMask();
 }
 
 UiInputActions uiInputPoll()
 {
     UiInputActions actions{};
 
-    actions.pagePrev = consumeRelease(Key::Left);
-    actions.pageNext = consumeRelease(Key::Right);
-    actions.selectNext = consumeRelease(Key::Up);
-    actions.back = consumeRelease(Key::Down);
-    actions.enter = consumeRelease(Key::Center);
-    actions.dec = consumeShort(Key::F1);
-    actions.inc = consumeShort(Key::F2);
-    actions.decFast = keyLongPress(Key::F1, true, kFastRepeatMs, kFastThresholdMs);
-    actions.incFast = keyLongPress(Key::F2, true, kFastRepeatMs, kFastThresholdMs);
+    ButtonEvent ev;
+    while (buttonsPollEvent(ev))
+    {
+        const uint16_t keyBit = KEY_BIT(ev.key);
+        if (ignoreMask & keyBit)
+        {
+            if (ev.type == ButtonEventType::Release)
+                ignoreMask &= (uint16_t)~keyBit;
+            continue;
+        }
+
+        if (ev.type == ButtonEventType::Release)
+        {
+            switch (ev.key)
+            {
+            case Key::Left:
+                actions.pagePrev = true;
+                break;
+            case Key::Right:
+                actions.pageNext = true;
+                break;
+            case Key::Up:
+                actions.selectNext = true;
+                break;
+            case Key::Down:
+                actions.back = true;
+                break;
+            case Key::Center:
+                actions.enter = true;
+                break;
+            case Key::F1:
+                actions.dec |= ev.heldMs < BUTTONS_LONG_MS;
+                break;
+            case Key::F2:
+                actions.inc |= ev.heldMs < BUTTONS_LONG_MS;
+                break;
+            default:
+                break;
+            }
+        }
+        else if (ev.type == ButtonEventType::Long || ev.type == ButtonEventType::Repeat)
+        {
+            if (ev.key == Key::F1)
+                actions.decFast |= fastStep(ev);
+            else if (ev.key == Key::F2)
+                actions.incFast |= fastStep(ev);
+        }
+    }
 
     return actions;
 }
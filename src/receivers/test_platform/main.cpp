@@ -1,17 +1,31 @@
 #include <Arduino.h>
 #include "receivers/test_platform/config.h"
 #include "common/comm.h"
+#include "common/telemetry.h"
+#include "common/scheduler.h"
+#include "receiver/failsafe.h"
+#include "receiver/bind_store.h"
+#include "receiver/output.h"
+#include "receiver/smoothing.h"
+
+#if OUTPUT_ENABLED && OUTPUT_MODE == 2 && SERIAL_ENABLED
+#error "SBUS output uses the UART: set SERIAL_ENABLED 0"
+#endif
 
 
-static CommFrame lastRx{};
-static uint32_t lastLog = 0;
-static uint32_t lastHeartbeat = 0;
+static CommFrame outFrame{}; // what the outputs are driven with (failsafe applied)
+static CommFailsafeConfig fsCfg{};
+static BindRecord bind{};
+static bool bound = false;
+static uint32_t bindUntil = 0;   // bind window end (while in bind mode)
+static uint32_t bindTakenAt = 0; // offer received, switching after BIND_LINGER_MS
 static bool radioReady = false;
 static uint32_t lastRxAt = 0;
 static uint32_t rxCount = 0;
-static uint32_t lastDiag = 0;
 static uint16_t lastBatteryMv = 0;
 static uint8_t lastBatteryPct = 0;
+static uint32_t lastProfileScan = 0;
+static uint32_t loopCount = 0;
 
 static uint8_t batteryPctFromMv(uint32_t mv)
 {
@@ -41,100 +55,259 @@ static uint16_t readBatteryMv()
     return (battMv > 0xFFFFUL) ? 0xFFFFU : (uint16_t)battMv;
 }
 
-void setup()
-{
 #if SERIAL_ENABLED
-    Serial.begin(SERIAL_BAUD); // USB serial logs
+// Heartbeat to confirm the loop is running, then radio diagnostics (1 Hz)
+static void diagTask()
+{
+    Serial.println("tick");
+
+    Serial.print("RADIO: ");
+    Serial.print(radioReady ? "OK" : "OFF");
+    Serial.print(" | RX/s: ");
+    Serial.print(rxCount);
+    Serial.print(" | lastRxAge ms: ");
+    Serial.print(millis() - lastRxAt);
+    Serial.print(" | PROFILE: ");
+    Serial.print(commGetLinkProfileInfo(commGetLinkProfile()).name);
+    Serial.print(" | CH: ");
+    Serial.print(commGetChannel());
+    Serial.print(commRxHopSynced() ? " SYNC" : " ACQ");
+    const FailsafeStats fs = failsafeGetStats();
+    Serial.print(" | FS: ");
+    Serial.print(fs.active ? "ON" : "off");
+    Serial.print(" x");
+    Serial.print(fs.activations);
+    Serial.print(" det us: ");
+    Serial.print(fs.lastDetectUs);
+    Serial.print("/");
+    Serial.println(fs.thresholdUs);
+    rxCount = 0;
+}
+
+static void logTask()
+{
+    Serial.print(failsafeGetStats().active ? "FS" : "OK");
+    Serial.print(" | LX: ");
+    Serial.print(commChannelToPct(outFrame.ch[COMM_CH_LX]));
+    Serial.print(" | LY: ");
+    Serial.print(commChannelToPct(outFrame.ch[COMM_CH_LY]));
+    Serial.print(" | RX: ");
+    Serial.print(commChannelToPct(outFrame.ch[COMM_CH_RX]));
+    Serial.print(" | RY: ");
+    Serial.print(commChannelToPct(outFrame.ch[COMM_CH_RY]));
+    Serial.print(" | AUX: ");
+    for (uint8_t i = COMM_CH_AUX_JL; i < outFrame.channelCount; ++i)
+        Serial.print(commChannelIsHigh(outFrame.ch[i]) ? 1 : 0);
+    Serial.print(" | BATT: ");
+    Serial.print(lastBatteryPct);
+    Serial.print("%");
+    Serial.println();
+}
 #endif
 
+static void batteryTask()
+{
+    lastBatteryMv = readBatteryMv();
+    lastBatteryPct = batteryPctFromMv(lastBatteryMv);
+    telemetrySet(TelemetryId::RxBattPct, lastBatteryPct, 1);
+    telemetrySet(TelemetryId::RxBattMv, lastBatteryMv, 2);
+}
+
+// Rate telemetry (1 Hz window)
+static void telemetryTask()
+{
+    CommRxStats st{};
+    commRxTakeStats(st);
+    const uint8_t rssiPct = st.frames ? (uint8_t)(((uint32_t)st.carrier * 100UL) / st.frames) : 0;
+    telemetrySet(TelemetryId::RxLoopHz, loopCount > 0xFFFFUL ? 0xFFFFU : loopCount, 2);
+    telemetrySet(TelemetryId::RxFrameRate, st.frames, 2);
+    telemetrySet(TelemetryId::RxRssi, rssiPct, 1);
+    const FailsafeStats fs = failsafeGetStats();
+    telemetrySet(TelemetryId::RxFsLatencyMs, fs.lastDetectUs / 1000UL, 2);
+    telemetrySet(TelemetryId::RxFsCount, fs.activations, 2);
+    loopCount = 0;
+}
+
+// Every pass: radio, failsafe, smoothing, outputs
+static void radioTask()
+{
+// Bind mode: wait for an offer, then switch to the new pair address
 #if NRF_ENABLED
-    radioReady = commInit(NRF24_CE_PIN, NRF24_CSN_PIN, NRF_CHANNEL, NRF_ADDR);
+    if (radioReady && commIsBindMode())
+    {
+        CommFrame unused{};
+        commPollFrame(unused); // services the radio, control frames are ignored
+        BindRecord offer{};
+        if (commTakeBind(offer.address, offer.modelId) && bindTakenAt == 0)
+        {
+            bind = offer;
+            bound = true;
+            bindStoreSave(bind);
+            telemetrySet(TelemetryId::RxModelId, bind.modelId, 1);
+            bindTakenAt = millis();
+        }
+
+        if (bindTakenAt != 0 && millis() - bindTakenAt >= BIND_LINGER_MS)
+        {
+            commSetAddress(bind.address);
+            commSetBindMode(false);
+            lastRxAt = millis();
 #if SERIAL_ENABLED
-    if (!radioReady)
+            Serial.print("BIND: OK model ");
+            Serial.println(bind.modelId);
+#endif
+        }
+        else if (bindTakenAt == 0 && (int32_t)(millis() - bindUntil) >= 0)
+        {
+            commSetBindMode(false); // window over: keep the stored (or default) address
+            lastRxAt = millis();
+#if SERIAL_ENABLED
+            Serial.println("BIND: timeout");
+#endif
+        }
+        failsafeUpdate(micros(), outFrame); // no control frames while binding
+#if OUTPUT_ENABLED
+        outputWrite(outFrame);
+#endif
+        return;
+    }
+#endif
+
+// Send telemetry to transmitter, receive control frame
+#if NRF_ENABLED
+    if (radioReady)
     {
-        Serial.println("NRF24 not detected, radio disabled");
+        commSendTelemetry();
     }
+    CommFrame rx{};
+    uint32_t rxAtUs = 0;
+    if (radioReady && commPollFrame(rx, &rxAtUs))
+    {
+        lastRxAt = millis();
+        rxCount++;
+        failsafeOnFrame(rx, rxAtUs); // arrival time, not when loop() got to it
+#if SMOOTH_ENABLED
+        smoothOnFrame(rx, rxAtUs);
 #endif
+
+        // With controller time slots frames come every few link periods
+        const uint32_t intervalUs = commRxFrameIntervalUs();
+        failsafeSetPeriod(intervalUs);
+#if SMOOTH_ENABLED
+        smoothSetInterval(intervalUs);
 #endif
-    pinMode(BATTERY_PIN, INPUT);
+    }
+    if (radioReady && commTakeFailsafeConfig(fsCfg))
+    {
+        failsafeSetConfig(fsCfg);
+    }
 
-#if SERIAL_ENABLED
-    Serial.println("Receiver (Nano) start");
+    // No frames: controller may use another link profile, step to the next one
+    if (radioReady &&
+        millis() - lastRxAt >= NRF_PROFILE_SCAN_MS &&
+        millis() - lastProfileScan >= NRF_PROFILE_SCAN_MS)
+    {
+        lastProfileScan = millis();
+        const uint8_t next = ((uint8_t)commGetLinkProfile() + 1) % (uint8_t)CommLinkProfile::Count;
+        commSetLinkProfile((CommLinkProfile)next);
+        failsafeSetPeriod(commGetLinkProfileInfo(commGetLinkProfile()).txPeriodUs);
+    }
+#endif
+
+    const bool fsActive = failsafeUpdate(micros(), outFrame);
+#if SMOOTH_ENABLED
+    // Failsafe values go out as they are; smoothing restarts from the next frame
+    if (fsActive)
+        smoothReset();
+    else
+        smoothUpdate(micros(), outFrame);
+#else
+    (void)fsActive;
+#endif
+#if OUTPUT_ENABLED
+    outputWrite(outFrame);
 #endif
 }
 
-void loop()
+void setup()
 {
 #if SERIAL_ENABLED
-    // Heartbeat to confirm loop is running
-    if (millis() - lastHeartbeat >= 1000)
-    {
-        lastHeartbeat = millis();
-        Serial.println("tick");
-    }
+    Serial.begin(SERIAL_BAUD); // USB serial logs
+#endif
 
-    // Radio diagnostics (1 Hz)
-    if (millis() - lastDiag >= 1000)
+#if NRF_ENABLED
+    pinMode(BIND_BUTTON_PIN, INPUT_PULLUP);
+    bound = bindStoreLoad(bind);
+    radioReady = commInit(NRF24_CE_PIN, NRF24_CSN_PIN, NRF_CHANNEL, bound ? bind.address : NRF_ADDR, (CommLinkProfile)NRF_LINK_PROFILE);
+    failsafeInit(commGetLinkProfileInfo(commGetLinkProfile()).txPeriodUs, FAILSAFE_MISSED_PERIODS);
+    fsCfg = failsafeGetConfig();
+#if SMOOTH_ENABLED
+    smoothInit(commRxFrameIntervalUs());
+    SmoothConfig smooth = smoothGetConfig();
+    smooth.extrapFrames = SMOOTH_EXTRAP_FRAMES;
+    for (uint8_t i = 0; i < SMOOTH_CHANNELS && i < COMM_MAX_CHANNELS; ++i)
     {
-        lastDiag = millis();
-        Serial.print("RADIO: ");
-        Serial.print(radioReady ? "OK" : "OFF");
-        Serial.print(" | RX/s: ");
-        Serial.print(rxCount);
-        Serial.print(" | lastRxAge ms: ");
-        Serial.println(millis() - lastRxAt);
-        rxCount = 0;
+        smooth.mode[i] = (SmoothMode)SMOOTH_MODE_MAP[i];
+        smooth.strength[i] = SMOOTH_STRENGTH_MAP[i];
     }
+    smoothSetConfig(smooth);
 #endif
+    if (bound)
+        telemetrySet(TelemetryId::RxModelId, bind.modelId, 1);
 
-    static uint32_t lastBatteryRead = 0;
-    if (millis() - lastBatteryRead >= BATTERY_READ_INTERVAL_MS)
+    if (radioReady && (!bound || digitalRead(BIND_BUTTON_PIN) == LOW))
     {
-        lastBatteryRead = millis();
-        lastBatteryMv = readBatteryMv();
-        lastBatteryPct = batteryPctFromMv(lastBatteryMv);
+        commSetBindMode(true);
+        bindUntil = millis() + BIND_WINDOW_MS;
+#if SERIAL_ENABLED
+        Serial.println("BIND: waiting for controller");
+#endif
     }
+#if SERIAL_ENABLED
+    if (!radioReady)
+    {
+        Serial.println("NRF24 not detected, radio disabled");
+    }
+#endif
+#endif
+    pinMode(BATTERY_PIN, INPUT);
 
-    // Send battery telemetry to transmitter
-    CommFrame tx{};
-    tx.battPct = lastBatteryPct;
-
-// Receive control frame
-#if NRF_ENABLED
-    if (radioReady)
+#if OUTPUT_ENABLED
+    OutputConfig out{};
+    out.mode = (OutputMode)OUTPUT_MODE;
+    out.pwmRateHz = OUTPUT_PWM_RATE_HZ;
+    out.count = OUTPUT_COUNT;
+    for (uint8_t i = 0; i < OUTPUT_COUNT; ++i)
     {
-        commSendFrame(tx);
+        out.channel[i] = OUTPUT_CHANNEL_MAP[i];
+        out.pin[i] = OUTPUT_PINS[i];
     }
-    CommFrame rx{};
-    if (radioReady && commPollFrame(rx))
+    const bool outputOk = outputInit(out);
+#if SERIAL_ENABLED
+    if (!outputOk)
     {
-        lastRx = rx;
-        lastRxAt = millis();
-        rxCount++;
+        Serial.println("Output config invalid, outputs disabled");
     }
+#else
+    (void)outputOk;
+#endif
 #endif
 
-    // Log every 250 ms
-    if (millis() - lastLog >= 250)
-    {
-        lastLog = millis();
+    schedAdd("radio", radioTask, 0, 0, 3);
+    schedAdd("battery", batteryTask, BATTERY_READ_INTERVAL_MS * 1000UL, 0, 1);
+    schedAdd("telemetry", telemetryTask, 1000000UL, 1000000UL, 1);
 #if SERIAL_ENABLED
-        Serial.print(" | LX: ");
-        Serial.print(lastRx.lx);
-        Serial.print(" | LY: ");
-        Serial.print(lastRx.ly);
-        Serial.print(" | RX: ");
-        Serial.print(lastRx.rx);
-        Serial.print(" | RY: ");
-        Serial.print(lastRx.ry);
-        Serial.print(" | JL: ");
-        Serial.print((lastRx.joyButtons & 0x01u) ? 1 : 0);
-        Serial.print(" | JR: ");
-        Serial.print((lastRx.joyButtons & 0x02u) ? 1 : 0);
-        Serial.print(" | BATT: ");
-        Serial.print(tx.battPct);
-        Serial.print("%");
-        Serial.println();
+    schedAdd("diag", diagTask, 1000000UL, 1000000UL, 0);
+    schedAdd("log", logTask, 250000UL, 250000UL, 0);
 #endif
-    }
+
+#if SERIAL_ENABLED
+    Serial.println("Receiver (Nano) start");
+#endif
+}
+
+void loop()
+{
+    loopCount++;
+    schedRun();
 }
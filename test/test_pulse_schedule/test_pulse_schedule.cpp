@@ -0,0 +1,173 @@
+#include <unity.h>
+#include <receiver/pulse_schedule.h>
+
+// Edge lists must come out in time order, PPM frames must keep their
+// sync gap at every channel count, and the PWM frame/gap limits must
+// hold exactly at their edges.
+
+static PulseSchedule sched;
+
+void setUp()
+{
+    sched = PulseSchedule{};
+}
+
+void tearDown() {}
+
+static void assertSorted(const PulseSchedule &s)
+{
+    for (uint8_t i = 1; i < s.edgeCount; ++i)
+        TEST_ASSERT_TRUE(s.edge[i - 1].atUs <= s.edge[i].atUs);
+    if (s.edgeCount > 0)
+        TEST_ASSERT_TRUE(s.edge[s.edgeCount - 1].atUs < s.frameUs);
+}
+
+static void test_pwm_edges_sorted_and_merged()
+{
+    const uint16_t w[OUTPUT_MAX_CHANNELS] = {1800, 1200, 0, 1500, 1200, 2500, 900, 1800};
+    TEST_ASSERT_TRUE(pulseBuildPwm(w, OUTPUT_MAX_CHANNELS, pulsePwmFrameUs(50), sched));
+    assertSorted(sched);
+
+    // Rise of all live outputs, then 1000 (clamped 900), 1200 x2, 1500, 1800 x2, 2000 (clamped 2500)
+    TEST_ASSERT_EQUAL_UINT8(6, sched.edgeCount);
+    TEST_ASSERT_EQUAL_UINT16(0, sched.edge[0].atUs);
+    TEST_ASSERT_EQUAL_UINT8(0xFB, sched.edge[0].mask);
+    TEST_ASSERT_EQUAL_UINT8(1, sched.edge[0].level);
+
+    const uint16_t at[] = {1000, 1200, 1500, 1800, 2000};
+    const uint8_t mask[] = {0x40, 0x12, 0x08, 0x81, 0x20};
+    uint8_t fell = 0;
+    for (uint8_t i = 0; i < 5; ++i)
+    {
+        TEST_ASSERT_EQUAL_UINT16(at[i], sched.edge[i + 1].atUs);
+        TEST_ASSERT_EQUAL_UINT8(mask[i], sched.edge[i + 1].mask);
+        TEST_ASSERT_EQUAL_UINT8(0, sched.edge[i + 1].level);
+        fell = (uint8_t)(fell | sched.edge[i + 1].mask);
+    }
+    TEST_ASSERT_EQUAL_UINT8(sched.edge[0].mask, fell); // every rise gets one fall
+}
+
+static void test_pwm_all_cut_has_no_edges()
+{
+    const uint16_t w[OUTPUT_MAX_CHANNELS] = {};
+    TEST_ASSERT_TRUE(pulseBuildPwm(w, OUTPUT_MAX_CHANNELS, pulsePwmFrameUs(50), sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+}
+
+static void test_pwm_channel_count_limits()
+{
+    const uint16_t w[OUTPUT_MAX_CHANNELS + 1] = {1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500, 1500};
+    TEST_ASSERT_TRUE(pulseBuildPwm(w, 0, pulsePwmFrameUs(50), sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+
+    TEST_ASSERT_TRUE(pulseBuildPwm(w, OUTPUT_MAX_CHANNELS, pulsePwmFrameUs(50), sched));
+    TEST_ASSERT_EQUAL_UINT8(2, sched.edgeCount);
+    TEST_ASSERT_EQUAL_UINT8(0xFF, sched.edge[0].mask);
+
+    TEST_ASSERT_FALSE(pulseBuildPwm(w, OUTPUT_MAX_CHANNELS + 1, pulsePwmFrameUs(50), sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+}
+
+static void test_pwm_frame_length_and_min_gap()
+{
+    TEST_ASSERT_EQUAL_UINT16(20000, pulsePwmFrameUs(50));
+    TEST_ASSERT_EQUAL_UINT16(2500, pulsePwmFrameUs(400));
+    TEST_ASSERT_EQUAL_UINT16(20000, pulsePwmFrameUs(10));   // clamped to the lowest rate
+    TEST_ASSERT_EQUAL_UINT16(2500, pulsePwmFrameUs(1000));  // clamped to the highest rate
+
+    // The highest rate still leaves the minimum low time after a full pulse
+    TEST_ASSERT_TRUE(pulsePwmFrameUs(OUTPUT_PWM_RATE_MAX_HZ) - OUTPUT_PULSE_MAX_US >= OUTPUT_PWM_GAP_MIN_US);
+
+    // A frame exactly one full pulse plus the minimum gap is accepted, one us less is not
+    const uint16_t w[1] = {OUTPUT_PULSE_MAX_US};
+    TEST_ASSERT_TRUE(pulseBuildPwm(w, 1, OUTPUT_PULSE_MAX_US + OUTPUT_PWM_GAP_MIN_US, sched));
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PULSE_MAX_US + OUTPUT_PWM_GAP_MIN_US, sched.frameUs);
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PULSE_MAX_US, sched.edge[1].atUs);
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PWM_GAP_MIN_US, sched.frameUs - sched.edge[1].atUs);
+
+    TEST_ASSERT_FALSE(pulseBuildPwm(w, 1, OUTPUT_PULSE_MAX_US + OUTPUT_PWM_GAP_MIN_US - 1, sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+}
+
+static uint16_t clampUs(uint16_t us)
+{
+    if (us < OUTPUT_PULSE_MIN_US)
+        return OUTPUT_PULSE_MIN_US;
+    return us > OUTPUT_PULSE_MAX_US ? OUTPUT_PULSE_MAX_US : us;
+}
+
+static void checkPpm(const uint16_t *w, uint8_t count)
+{
+    TEST_ASSERT_TRUE(pulseBuildPpm(w, count, sched));
+    assertSorted(sched);
+    TEST_ASSERT_EQUAL_UINT8(2 * count + 2, sched.edgeCount);
+
+    // Sync low then high per channel; rising to rising edge is the channel width
+    uint32_t t = 0;
+    for (uint8_t i = 0; i <= count; ++i)
+    {
+        const PulseEdge &lo = sched.edge[2 * i];
+        const PulseEdge &hi = sched.edge[2 * i + 1];
+        TEST_ASSERT_EQUAL_UINT8(0, lo.level);
+        TEST_ASSERT_EQUAL_UINT8(1, hi.level);
+        TEST_ASSERT_EQUAL_UINT16(t, lo.atUs);
+        TEST_ASSERT_EQUAL_UINT16(OUTPUT_PPM_SYNC_US, hi.atUs - lo.atUs);
+        if (i < count)
+            t += clampUs(w[i]);
+    }
+
+    // The sync gap after the closing pulse never drops below the minimum
+    const uint16_t closing = sched.edge[2 * count].atUs;
+    TEST_ASSERT_TRUE(sched.frameUs - closing >= OUTPUT_PPM_GAP_MIN_US);
+    TEST_ASSERT_TRUE(sched.frameUs >= OUTPUT_PPM_FRAME_US);
+}
+
+static void test_ppm_frame_at_channel_limits()
+{
+    const uint16_t full[OUTPUT_MAX_CHANNELS + 1] = {2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000, 2000};
+    const uint16_t low[OUTPUT_MAX_CHANNELS] = {1000, 1000, 1000, 1000, 1000, 1000, 1000, 1000};
+
+    checkPpm(full, 1);
+    checkPpm(low, 1);
+    checkPpm(full, OUTPUT_MAX_CHANNELS);
+    checkPpm(low, OUTPUT_MAX_CHANNELS);
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PPM_FRAME_US, sched.frameUs);
+
+    TEST_ASSERT_FALSE(pulseBuildPpm(full, 0, sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+    TEST_ASSERT_FALSE(pulseBuildPpm(full, OUTPUT_MAX_CHANNELS + 1, sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+}
+
+static void test_ppm_cut_channels()
+{
+    // A cut channel goes out at the minimum width; all cut stops the train
+    const uint16_t some[3] = {1500, 0, 1700};
+    checkPpm(some, 3);
+    TEST_ASSERT_EQUAL_UINT16(1500 + OUTPUT_PULSE_MIN_US, sched.edge[4].atUs);
+
+    const uint16_t none[3] = {0, 0, 0};
+    TEST_ASSERT_TRUE(pulseBuildPpm(none, 3, sched));
+    TEST_ASSERT_EQUAL_UINT8(0, sched.edgeCount);
+}
+
+static void test_channel_to_us()
+{
+    TEST_ASSERT_EQUAL_UINT16(0, pulseChannelToUs(COMM_CH_CUT));
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PULSE_MIN_US, pulseChannelToUs(COMM_CH_MIN));
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PULSE_CENTER_US, pulseChannelToUs(COMM_CH_CENTER));
+    TEST_ASSERT_EQUAL_UINT16(OUTPUT_PULSE_MAX_US, pulseChannelToUs(COMM_CH_MAX));
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pwm_edges_sorted_and_merged);
+    RUN_TEST(test_pwm_all_cut_has_no_edges);
+    RUN_TEST(test_pwm_channel_count_limits);
+    RUN_TEST(test_pwm_frame_length_and_min_gap);
+    RUN_TEST(test_ppm_frame_at_channel_limits);
+    RUN_TEST(test_ppm_cut_channels);
+    RUN_TEST(test_channel_to_us);
+    return UNITY_END();
+}